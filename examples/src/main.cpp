@@ -30,6 +30,7 @@ void execMultiOk(Connection& conn);
 
 void transact(Connection& conn);
 void transactManual(Connection& conn);
+void transactRetry(Connection& conn);
 
 void result(Connection& conn);
 void resultVars(Connection& conn);
@@ -45,14 +46,29 @@ void escape(Connection& conn);
 void send(Connection& conn);
 void sendTWice(Connection& conn);
 void sendRowByRow(Connection& conn);
+void sendAbandon(Connection& conn);
+void stream(Connection& conn);
+void cursor(Connection& conn);
+
+void sharedConnection();
+void sharedConnectionBuilder();
 
 void myTableUpdate(Connection& conn);
 void myTableVisit(Connection& conn);
+void myTableReturning(Connection& conn);
 
 void pool();
+void poolStream();
+void poolTimeout();
+void poolPriority();
+void poolFlows();
+void poolBackpressure();
+void poolRetry();
 void poolConfig();
 void poolPrepare();
 void poolBehaviour();
+void poolStats();
+void subscribe();
 
 int main() {
     Connection conn{};
@@ -86,6 +102,7 @@ int main() {
 
     transact(conn);
     transactManual(conn);
+    transactRetry(conn);
 
     result(conn);
     resultVars(conn);
@@ -101,12 +118,28 @@ int main() {
     send(conn);
     sendTWice(conn);
     sendRowByRow(conn);
+    sendAbandon(conn);
+    stream(conn);
+    cursor(conn);
+
+    sharedConnection();
+    sharedConnectionBuilder();
 
     myTableUpdate(conn);
     myTableVisit(conn);
+    myTableReturning(conn);
 
     pool();
+    poolStream();
+    poolTimeout();
+    poolPriority();
+    poolFlows();
+    poolBackpressure();
+    poolRetry();
     poolConfig();
     poolPrepare();
     poolBehaviour();
+    poolStats();
+
+    subscribe();
 }
@@ -377,6 +377,9 @@ void transact(Connection& conn) {
 /// The `transact()` accepts anything the `exec()` does:
 /// strings, `Command`*s*, `PreparedCommand`*s* and `PrepareData` in any combination.
 /// Either all of them succeed or none have any effect.
+/// The statements are sent to a server in a single pipeline from `BEGIN` to `COMMIT`,
+/// so the whole transaction costs one round trip and holds locks no longer than needed.
+/// The result of the last statement is returned.
 /// Again the example is a bit ridiculous, but imagine statements to be more meaningful,
 /// for instance, inserting data to two different tables when one insert without the other
 /// would leave a system in inconsistent state.
@@ -394,6 +397,29 @@ void transactManual(Connection& conn) {
 /// and build more complex and flexible transactions.
 /// When a transaction handle goes out of scope it rollbacks the transaction
 /// unless it has been explicitly committed already.
+///
+/// Concurrent transactions may fail with serialization errors or deadlocks
+/// which go away when the transaction is simply run again.
+/// The third way replays the whole body of a transaction in such cases:
+/// ```cpp
+using postgres::IsolationLevel;
+using postgres::RetryPolicy;
+
+void transactRetry(Connection& conn) {
+    auto const policy = RetryPolicy{}
+                            .attempts(3)
+                            .backoff(10ms, 100ms)
+                            .isolation(IsolationLevel::SERIALIZABLE);
+    auto const res = conn.retryTransaction([](Connection& conn) {
+        conn.exec("SELECT 1");
+        return conn.exec("SELECT 2");
+    }, policy);
+}
+/// ```
+/// Failures with SQLSTATE codes other than 40001 and 40P01 or ones added with `retryOn()`
+/// are thrown as usual, as well as the last one when all attempts are used up.
+/// The body may be run several times, so it must not have side effects outside the database.
+/// `Client` offers the same with `retryTransaction()` running the body on a worker.
 
 /// ### Reading the Result
 ///
@@ -625,6 +651,98 @@ void sendRowByRow(Connection& conn) {
 /// ```
 /// Notice that the result is checked for emptiness inside the loop body -
 /// this is because of how libpq works, and you always have to do the same thing.
+///
+/// Leaving the loop early doesn't stop the statement:
+/// the rest of the rows are received and discarded when the receiver is destroyed.
+/// To cancel the statement instead set the abandon policy of the connection.
+/// There is also an explicit `cancel()` method of the receiver.
+/// ```cpp
+using postgres::AbandonPolicy;
+
+void sendAbandon(Connection& conn) {
+    conn.abandonPolicy(AbandonPolicy::CANCEL);
+    for (auto const& res : conn.iter("SELECT generate_series(1, 1000000)")) {
+        if (!res.isEmpty()) {
+            break;
+        }
+    }
+    conn.abandonPolicy(AbandonPolicy::DRAIN);
+}
+/// ```
+///
+/// Allocating a separate result for every row is what makes the single-row mode slow.
+/// Streaming rows in chunks of limited size is almost as fast as receiving them all at once,
+/// while memory consumption stays bounded:
+/// ```cpp
+void stream(Connection& conn) {
+    for (auto const& row : conn.stream(Command{"SELECT generate_series(1, 3)"}, 1000)) {
+        std::cout << row[0].as<int>() << std::endl;
+    }
+}
+/// ```
+/// Chunks are either received natively, if supported by libpq,
+/// or fetched from a cursor within a transaction.
+///
+/// For long scans with heavy processing of each row consider a prefetching cursor instead.
+/// It requests the next batch of rows before handing over the current one,
+/// so that the server and the network keep working while you process the data.
+/// A memory limit makes it reduce the batch size for wide rows:
+/// ```cpp
+void cursor(Connection& conn) {
+    auto const query = Command{"SELECT generate_series(1, 3)"};
+    for (auto const& row : conn.cursor(query, 10000, 64 * 1024 * 1024)) {
+        std::cout << row[0].as<int>() << std::endl;
+    }
+}
+/// ```
+
+/// ### Shared Connection
+///
+/// A `Connection` must not be used by multiple threads at once.
+/// When many threads issue short statements, a `SharedConnection` lets them all use
+/// a single server connection, keeping `max_connections` low:
+/// ```cpp
+#include <thread>
+
+using postgres::SharedConnection;
+
+void sharedConnection() {
+    SharedConnection         conn{};
+    std::vector<std::thread> threads{};
+    for (auto i = 0; i < 4; ++i) {
+        threads.emplace_back([&conn, i] {
+            auto res = conn.exec(Command{"SELECT $1::INT", i});
+            std::cout << res.get()[0][0].as<int>() << std::endl;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+/// ```
+/// Statements are sent in the order of submission without waiting for the previous ones
+/// to complete, and each caller gets the result of its own statement through a future.
+/// Each statement runs in a separate transaction and failure of one doesn't affect the others,
+/// but since statements of different threads interleave, there are no multi-statement transactions.
+/// The connection is not restored once lost, so check `isOk()` and create a new one then.
+///
+/// Statements can be spread over several connections, all of them driven by a single thread.
+/// Where the kernel allows it, their sockets are polled with io_uring, handling a batch
+/// of submissions and completions per system call; otherwise epoll is used:
+/// ```cpp
+using postgres::EventBackend;
+
+void sharedConnectionBuilder() {
+    auto conn = SharedConnection::Builder{}
+                    .connections(4)
+                    .backend(EventBackend::IO_URING)
+                    .prepare(PrepareData{"my_select", "SELECT $1::INT"})
+                    .build();
+    std::cout << conn.exec(PreparedCommand{"my_select", 1}).get()[0][0].as<int>() << std::endl;
+}
+/// ```
+/// Prepared statements live in a connection, so the ones prepared by the builder
+/// are created on each connection once it is established.
 
 /// ### Generating Statements
 ///
@@ -753,6 +871,31 @@ void myTableVisit(Connection& conn) {
 /// and unsigned ones for bitmasks.
 /// The design decision for table generation was to utilize unsigned integers
 /// to create auto-incremented fields, which are useful for producing unique identifiers.
+///
+/// Generated identifiers can be obtained in the same round trip as the insert itself.
+/// The `insertReturning()` method leaves auto-incremented fields to the database
+/// and writes all the returned values back into the inserted objects, keeping their order:
+/// ```cpp
+struct MySerialTable {
+    uint32_t    id;
+    std::string info;
+
+    POSTGRES_CXX_TABLE("my_serial_table", id, info);
+};
+
+void myTableReturning(Connection& conn) {
+    conn.create<MySerialTable>();
+
+    std::vector<MySerialTable> data{{0, "foo"},
+                                    {0, "bar"}};
+    conn.insertReturning(data.begin(), data.end());
+
+    // Prints "1 2".
+    std::cout << data[0].id << " " << data[1].id << std::endl;
+
+    conn.drop<MySerialTable>();
+}
+/// ```
 
 /// ### Connection Pool
 ///
@@ -776,8 +919,64 @@ void pool() {
     std::cout << res.get().size() << std::endl;
 }
 /// ```
-/// The `Client` implements single-producer-multiple-consumers pattern
-/// and is not thread-safe by itself: protect it with a mutex for concurrent access.
+/// Large results don't have to be received entirely before you can start processing them.
+/// A client can stream rows from one of its connections to the calling thread:
+/// ```cpp
+void poolStream() {
+    Client cl{};
+    for (auto const& row : cl.stream(Command{"SELECT generate_series(1, 3)"})) {
+        std::cout << row[0].as<int>() << std::endl;
+    }
+}
+/// ```
+/// Rows are passed over in chunks through a queue of limited size.
+/// A connection stops receiving rows while the queue is full,
+/// so the memory consumption stays constant however slow the processing is.
+/// The stream must either be iterated to the end or destroyed to release the connection.
+///
+/// A job can be given a timeout to bound the time it takes:
+/// ```cpp
+using postgres::TimeoutError;
+
+void poolTimeout() {
+    Client cl{};
+    auto   res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT pg_sleep(1)");
+    }, 100ms);
+
+    try {
+        res.get();
+    } catch (TimeoutError const& err) {
+        std::cout << err.what() << std::endl;
+    }
+}
+/// ```
+/// A job that has not been started by the deadline is dropped without being executed.
+/// A running one has its statement cancelled on the server.
+/// Either way the future fails with `TimeoutError`, which is derived from `RuntimeError`.
+///
+/// Jobs can be prioritized to keep latency-critical requests from waiting behind a batch of heavy ones:
+/// ```cpp
+using postgres::Priority;
+
+void poolPriority() {
+    Client cl{};
+    auto   report = cl.query([](Connection& conn) {
+        return conn.exec("SELECT generate_series(1, 1000)");
+    }, Priority::BULK);
+
+    auto user = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, Priority::INTERACTIVE, 1s);
+
+    std::cout << user.get().size() << ' ' << report.get().size() << std::endl;
+}
+/// ```
+/// Queued jobs of higher priority are started first, the default priority is `NORMAL`.
+///
+/// The `Client` implements multiple-producers-multiple-consumers pattern
+/// and is thread-safe: any number of threads can submit jobs to the same client
+/// without extra locking.
 /// The interface is quite straightforward to use,
 /// however, a lot of flexibility is hidden in a connection pool's configuration,
 /// so let’s discover it.
@@ -807,13 +1006,26 @@ void poolPrepare() {
 /// ```
 /// And finally there are parameters affecting the behaviour of a connection pool:
 /// ```cpp
+using postgres::QueuePolicy;
 using postgres::ShutdownPolicy;
 
 void poolBehaviour() {
     Client cl{Context::Builder{}.idleTimeout(1min)
+                                .maxLifetime(1h)
+                                .validationInterval(30s)
                                 .maxConcurrency(2)
+                                .minConcurrency(1)
+                                .targetWait(10ms)
+                                .scalingInterval(100ms)
+                                .maxConnecting(2)
+                                .connectBackoff(100ms, 10s)
+                                .maxConnectAttempts(5)
                                 .maxQueueSize(30)
+                                .maxQueueSize(Priority::BULK, 10)
+                                .agingInterval(1s)
                                 .shutdownPolicy(ShutdownPolicy::DROP)
+                                .abandonPolicy(AbandonPolicy::CANCEL)
+                                .queuePolicy(QueuePolicy::EARLIEST_DEADLINE)
                                 .build()};
 }
 /// ```
@@ -821,16 +1033,155 @@ void poolBehaviour() {
 /// after specified duration of inactivity.
 /// Its primary purpose is to reduce the number of allocated resources back to the usual level
 /// after a load spike has gone.
+/// Threads stop one at a time, no more often than once per timeout,
+/// and only while less than a half of them are busy,
+/// so the pool doesn't reconnect on every traffic wave.
 /// This feature is disabled by default.
 ///
+/// Connections outliving the maximum lifetime are replaced with new ones once their jobs are done,
+/// releasing the memory accumulated by server processes.
+/// Idle connections are validated in the background with the given interval,
+/// so the first job after a quiet period doesn't run into a connection lost meanwhile.
+/// A broken connection is restored by its thread using the same backoff as for the new ones.
+/// Both features are disabled by default.
+///
 /// Maximum concurrency specifies the number of threads/connections
 /// and defaults to hardware concurrency.
+/// Minimum concurrency is the number of connections kept open despite the idle timeout.
+/// The pool grows on demand, by default whenever a job finds no idle connection.
+/// With a target wait set it grows only while jobs wait in the queue longer than that on average,
+/// and a scaling interval limits how often new connections are opened.
+/// Connections are established by the pool threads, one at a time unless configured otherwise,
+/// while the jobs wait in the queue rather than each of them triggering a connect.
+/// After a failure to connect the pool retries with a jittered exponential backoff
+/// for as long as there are jobs waiting.
+/// Once the maximum number of attempts in a row has failed with no connection left in the pool,
+/// the waiting jobs fail with the connection error, and the later ones do after a single attempt
+/// until the server is reachable again.
 /// Also the internal queue size can be limited.
 /// Exceeding the limit results in an exception in a thread calling the client methods.
 /// By default the queue is allowed to grow until application runs out of memory and crashes.
+/// A priority lane can be given a limit of its own, which applies instead of the overall one.
+/// To prevent starvation of lower priorities set the aging interval:
+/// every interval spent in the queue promotes a job by one priority level.
 ///
 /// Shutdown policy regulates how to handle the queue on shutdown.
 /// Default policy is to stop gracefully: all requests waiting in the queue will be executed.
 /// You can alternatively choose to drop the queue,
 /// but active requests are not canceled and can take some time to complete anyway.
 /// And the last one policy is to abort, resulting in an undefined behaviour.
+///
+/// Abandon policy is applied to pool connections and is described in the asynchronous interface section.
+///
+/// Queue policy regulates the order in which queued jobs are started.
+/// Jobs are started in order of submission by default,
+/// but under overload it pays to prefer the ones with the earliest deadline.
+/// Either way jobs which have outlived their timeout are dropped from the queue
+/// instead of occupying connections, failing their futures immediately.
+/// Admission statistics are at hand to keep an eye on the queue:
+/// ```cpp
+void poolStats() {
+    Client     cl{};
+    auto const stats = cl.stats();
+    std::cout << stats.accepted << ' '
+              << stats.rejected << ' '
+              << stats.expired << ' '
+              << stats.size << std::endl;
+}
+/// ```
+///
+/// When a pool is shared by several tenants, tag their jobs with flows
+/// to prevent any one of them from taking over all of the connections:
+/// ```cpp
+using postgres::FlowConfig;
+using postgres::JobOptions;
+
+void poolFlows() {
+    FlowConfig cfg{};
+    cfg.weight          = 2;
+    cfg.rate            = 100.0;
+    cfg.burst           = 10;
+    cfg.max_concurrency = 4;
+
+    Client cl{Context::Builder{}.flow("premium", cfg).build()};
+    auto   res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, JobOptions{}.flow("premium").priority(Priority::INTERACTIVE).timeout(1s));
+
+    std::cout << res.get().size() << std::endl;
+}
+/// ```
+/// Waiting flows take turns in proportion to their weights.
+/// A flow submitting jobs faster than its rate allows, beyond the burst, is refused with `RuntimeError`.
+/// Jobs of a flow exceeding its maximum concurrency wait for its running jobs to complete.
+/// Each of the flows not configured explicitly gets the default configuration,
+/// which sets no limits unless changed with `defaultFlow()`.
+///
+/// Rather than failing on a full queue, a submission can wait for room to free up,
+/// or give up at once with `tryExec()` and `tryQuery()`, which return an empty optional instead of throwing:
+/// ```cpp
+void poolBackpressure() {
+    Client cl{Context::Builder{}.maxQueueSize(100).watermarks(50, 90).build()};
+    auto   res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, JobOptions{}.block(1s));
+
+    auto const opt = cl.tryQuery([](Connection& conn) {
+        return conn.exec("SELECT 2");
+    });
+    if (!opt) {
+        std::cout << "try later" << std::endl;
+    }
+    std::cout << res.get().size() << ' ' << cl.stats().is_congested << std::endl;
+}
+/// ```
+/// A job still not admitted when the blocking timeout expires fails with `RuntimeError`,
+/// `Duration::max()` waits as long as it takes.
+/// Blocking applies to queue room only: jobs refused by a flow rate limit fail at once.
+/// The queue is reported congested once its size reaches the high watermark
+/// and until it drops back to the low one.
+///
+/// A job safe to run more than once can be marked idempotent by allowing it some retries.
+/// If its connection is lost, e.g. on a server failover, the job is queued again
+/// after a jittered backoff to be run on another connection:
+/// ```cpp
+void poolRetry() {
+    Client cl{};
+    auto   res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, JobOptions{}.retries(3));
+
+    std::cout << res.get().size() << std::endl;
+}
+/// ```
+/// Connection exceptions (SQLSTATE class 08) and server shutdowns (57P01-57P03) are retried,
+/// while the errors of the job itself are not.
+/// Statement errors are reported with `SqlError`, which carries the SQLSTATE code.
+
+/// ### Notifications
+///
+/// Instead of polling a table for changes you can subscribe to notifications sent with
+/// `NOTIFY` or `pg_notify()`.
+/// The `Subscriber` owns a dedicated connection and waits for incoming notifications
+/// in a background thread.
+/// The connection is restored automatically and all the channels are listened again.
+/// ```cpp
+using postgres::Notification;
+using postgres::Subscriber;
+
+void subscribe() {
+    auto sub = Subscriber::Builder{}.onReset([] {
+                                        std::cout << "might have missed some" << std::endl;
+                                    })
+                                    .build();
+    sub.subscribe("my_channel", [](Notification const& note) {
+        std::cout << note.channel << ": " << note.payload << std::endl;
+    });
+}
+/// ```
+/// Callbacks are invoked on the listening thread.
+/// Long running ones should rather be passed to an executor set by the builder,
+/// e.g. a thread pool of your choice.
+/// The reset callback is invoked each time the connection is established,
+/// so that you can reload the state you track, since notifications sent
+/// while the connection was lost are not delivered.
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace postgres::internal {
+
+class Listener;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+class Config;
+class Connection;
+
+// Keeps type-erased values tagged with notification channels.
+// Entries expire after a time to live, the least recently used ones are evicted
+// when the size limit is reached, and all entries tagged with a channel are dropped
+// as soon as a notification on that channel is received.
+// With a listener, values are not kept for a channel until LISTEN is confirmed on it.
+class Cache {
+public:
+    class Builder;
+    using Clock = std::chrono::steady_clock;
+    using Duration = Clock::duration;
+    using Value = std::shared_ptr<void const>;
+
+    Cache(Cache const& other) = delete;
+    Cache& operator=(Cache const& other) = delete;
+    Cache(Cache&& other) noexcept = delete;
+    Cache& operator=(Cache&& other) noexcept = delete;
+    ~Cache() noexcept;
+
+    Value get(std::string const& key);
+    void put(std::string const& key, std::string const& channel, Value val);
+    void erase(std::string const& key);
+    // Erases the entry only if it still holds the given value.
+    void erase(std::string const& key, Value const& val);
+    void invalidate(std::string const& channel);
+    void clear();
+
+    int size();
+    Duration timeToLive() const;
+    int maxSize() const;
+
+private:
+    struct Entry {
+        std::string       key;
+        std::string       channel;
+        Clock::time_point expiry;
+        Value             value;
+    };
+
+    using Entries = std::list<Entry>;
+
+    explicit Cache();
+
+    void erase(Entries::iterator it);
+
+    Duration                                            ttl_;
+    int                                                 max_size_;
+    Entries                                             entries_;
+    std::unordered_map<std::string, Entries::iterator> index_;
+    std::mutex                                          mtx_;
+    std::unique_ptr<internal::Listener>                 listener_;
+};
+
+class Cache::Builder {
+public:
+    explicit Builder();
+    Builder(Builder const& other) = delete;
+    Builder& operator=(Builder const& other) = delete;
+    Builder(Builder&& other) noexcept;
+    Builder& operator=(Builder&& other) noexcept;
+    ~Builder() noexcept;
+
+    Builder& timeToLive(Duration val);
+    Builder& maxSize(int val);
+
+    // Listen for invalidating notifications using a dedicated connection.
+    Builder& listen(Config cfg);
+    Builder& listen(std::string uri);
+
+    std::shared_ptr<Cache> share();
+
+private:
+    std::shared_ptr<Cache>      cache_;
+    std::function<Connection()> connect_;
+};
+
+}  // namespace postgres
@@ -1,8 +1,23 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Key.h>
+#include <postgres/Cache.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/JobOptions.h>
+#include <postgres/Priority.h>
+#include <postgres/QueueStats.h>
+#include <postgres/RetryPolicy.h>
+#include <postgres/Statement.h>
 
 namespace postgres::internal {
 
@@ -12,13 +27,16 @@ class Dispatcher;
 
 namespace postgres {
 
-class Connection;
 class Context;
+class PreparedCommand;
 class Result;
 class Status;
+class Stream;
 
 class Client {
 public:
+    using Duration = std::chrono::high_resolution_clock::duration;
+
     explicit Client();
     explicit Client(Context ctx);
     Client(Client const& other) = delete;
@@ -30,10 +48,136 @@ public:
     std::future<Status> exec(std::function<Status(Connection&)> job);
     std::future<Result> query(std::function<Result(Connection&)> job);
 
+    // Jobs not started in time are dropped, running ones have their commands cancelled.
+    // Either way the future fails with TimeoutError.
+    std::future<Status> exec(std::function<Status(Connection&)> job, Duration timeout);
+    std::future<Result> query(std::function<Result(Connection&)> job, Duration timeout);
+
+    // Queued jobs of higher priority are started first.
+    std::future<Status> exec(std::function<Status(Connection&)> job, Priority prio);
+    std::future<Result> query(std::function<Result(Connection&)> job, Priority prio);
+    std::future<Status> exec(std::function<Status(Connection&)> job,
+                             Priority prio,
+                             Duration timeout);
+    std::future<Result> query(std::function<Result(Connection&)> job,
+                              Priority prio,
+                              Duration timeout);
+
+    std::future<Status> exec(std::function<Status(Connection&)> job, JobOptions const& opts);
+    std::future<Result> query(std::function<Result(Connection&)> job, JobOptions const& opts);
+
+    // Return nothing instead of throwing if the job is refused due to the queue overflow
+    // or the rate limit of its flow, after waiting for room as long as the options allow.
+    std::optional<std::future<Status>> tryExec(std::function<Status(Connection&)> job,
+                                               JobOptions const& opts = JobOptions{});
+    std::optional<std::future<Result>> tryQuery(std::function<Result(Connection&)> job,
+                                                JobOptions const& opts = JobOptions{});
+
+    // The job is run in a transaction replayed on a worker as the policy allows,
+    // so it must have no effects outside the database.
+    std::future<Result> retryTransaction(std::function<Result(Connection&)> job,
+                                         RetryPolicy policy = RetryPolicy{},
+                                         JobOptions const& opts = JobOptions{});
+
+    // Identical commands submitted while one of them is in flight
+    // are executed only once, sharing the same read-only result.
+    // Arguments passed without copying must outlive the execution.
+    std::shared_future<Result> queryShared(Command cmd);
+    std::shared_future<Result> queryShared(PreparedCommand cmd);
+
+    // Rows are streamed by a worker in chunks, which are queued for the caller to consume.
+    // The worker stops receiving rows while the queue is full,
+    // so the stream must either be iterated to the end or destroyed.
+    Stream stream(Command cmd, int chunk_size = 1000, int max_chunks = 4);
+
+    QueueStats stats() const;
+
+    template <typename T>
+    std::shared_future<std::vector<T>> select() {
+        return select<T>(Command{Statement<T>::select()});
+    }
+
+    // Decoded rows are taken from the cache if one is set in the context.
+    // Cached entries are tagged with the table name of T to be invalidated
+    // by notifications sent on the channel of the same name.
+    template <typename T>
+    std::shared_future<std::vector<T>> select(Command cmd) {
+        using Rows = std::vector<T>;
+        using Future = std::shared_future<Rows>;
+
+        auto const key = internal::makeKey(cmd) + typeid(T).name();
+        if (cache_) {
+            if (auto const hit = cache_->get(key)) {
+                return *std::static_pointer_cast<Future const>(hit);
+            }
+        }
+
+        // The task forgets its own entry on failure, leaving any newer one in place.
+        auto const value = std::make_shared<std::weak_ptr<void const>>();
+        auto const task  = std::make_shared<std::packaged_task<Rows(Connection&)>>(
+            [cmd = std::make_shared<Command>(std::move(cmd)), cache = cache_, key, value](Connection& conn) {
+                try {
+                    return fetch<T>(conn, *cmd);
+                } catch (...) {
+                    if (cache) {
+                        if (auto const entry = value->lock()) {
+                            cache->erase(key, entry);
+                        }
+                    }
+                    throw;
+                }
+            });
+
+        Future res = task->get_future();
+        if (!cache_) {
+            post([task](Connection& conn) {
+                (*task)(conn);
+            });
+            return res;
+        }
+
+        Cache::Value const entry = std::make_shared<Future const>(res);
+        *value = entry;
+        cache_->put(key, Statement<T>::table(), entry);
+        try {
+            post([task](Connection& conn) {
+                (*task)(conn);
+            });
+        } catch (...) {
+            cache_->erase(key, entry);
+            throw;
+        }
+        return res;
+    }
+
 private:
     using Impl = internal::Dispatcher;
 
-    std::unique_ptr<Impl> impl_;
+    template <typename T>
+    static std::vector<T> fetch(Connection& conn, Command const& cmd) {
+        std::vector<T> out{};
+        auto const     res = conn.exec(cmd);
+        out.reserve(res.size());
+        for (auto row : res) {
+            out.emplace_back();
+            row >> out.back();
+        }
+        return out;
+    }
+
+    template <typename T>
+    std::future<T> submit(std::function<T(Connection&)> job, JobOptions const& opts);
+    template <typename T>
+    std::optional<std::future<T>> trySubmit(std::function<T(Connection&)> job,
+                                            JobOptions const& opts);
+
+    static std::chrono::steady_clock::time_point deadline(JobOptions const& opts);
+    static std::chrono::steady_clock::time_point until(JobOptions const& opts);
+
+    void post(std::function<void(Connection&)> job);
+
+    std::unique_ptr<Impl>  impl_;
+    std::shared_ptr<Cache> cache_;
 };
 
 }  // namespace postgres
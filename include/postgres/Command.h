@@ -8,6 +8,7 @@
 #include <vector>
 #include <postgres/internal/Bytes.h>
 #include <postgres/internal/Classifier.h>
+#include <postgres/internal/Visitors.h>
 #include <postgres/Oid.h>
 #include <postgres/Time.h>
 
@@ -70,6 +71,14 @@ private:
         }
     };
 
+    template <typename Iter>
+    void add(internal::InsertRange<Iter> const rng) {
+        Inserter ins{*this};
+        for (auto it = rng.beg; it != rng.end; ++it) {
+            internal::deref(*it).visitPostgresFields(ins);
+        }
+    };
+
     // Use mutable reference to disallow temporaries.
     template <typename T>
     std::enable_if_t<internal::isVisitable<T>()> add(T& arg) {
@@ -95,6 +104,30 @@ private:
     template <typename T>
     std::enable_if_t<std::is_arithmetic_v<T>> add(T arg) {
         auto constexpr LEN = sizeof(arg);
+        auto constexpr ID  = numberType<T>();
+
+        arg = internal::orderBytes(arg);
+        setMeta(ID, LEN, 1);
+        storeData(&arg, LEN);
+    };
+
+    // Arrays are passed in binary format.
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> add(std::vector<T> const& arr) {
+        auto constexpr LEN = static_cast<int32_t>(sizeof(T));
+        auto constexpr ID  = numberType<T>();
+
+        auto data = makeArray(ID, arr.size());
+        for (T val : arr) {
+            val = internal::orderBytes(val);
+            appendArrayItem(data, &val, LEN);
+        }
+        addArray(ID, data);
+    }
+
+    template <typename T>
+    static constexpr Oid numberType() {
+        auto constexpr LEN = sizeof(T);
         static_assert(LEN <= 8, "Unexpected arithmetic argument type length");
 
         auto constexpr ID = []() -> Oid {
@@ -110,11 +143,8 @@ private:
             return UNKNOWNOID;
         }();
         static_assert(ID != UNKNOWNOID, "Unexpected arithmetic argument type");
-
-        arg = internal::orderBytes(arg);
-        setMeta(ID, LEN, 1);
-        storeData(&arg, LEN);
-    };
+        return ID;
+    }
 
     void add(std::nullptr_t);
     void add(std::chrono::system_clock::time_point t);
@@ -122,10 +152,27 @@ private:
     void add(std::string const& s);
     void add(std::string_view s);
     void add(char const* s);
+    void add(std::vector<std::string> const& arr);
     void addText(char const* s, size_t len);
+    void addArray(Oid elem_id, std::vector<char> const& data);
     void setMeta(Oid id, int len, int fmt);
     void storeData(void const* arg, size_t len);
 
+    // Visitor which skips the fields generated by the database.
+    struct Inserter {
+        template <typename T>
+        void accept(char const* const name, T& arg) {
+            if constexpr (!internal::isGenerated<T>()) {
+                cmd.accept(name, arg);
+            }
+        };
+
+        Command& cmd;
+    };
+
+    static std::vector<char> makeArray(Oid elem_id, size_t size);
+    static void appendArrayItem(std::vector<char>& data, void const* item, int32_t len);
+
     void setStatement(std::string stmt);
     void setStatement(std::string_view stmt);
     void setStatement(char const* stmt);
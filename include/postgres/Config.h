@@ -7,6 +7,12 @@
 
 namespace postgres {
 
+enum class ReplicationMode {
+    PHYSICAL,
+    LOGICAL,
+    DEFAULT,
+};
+
 enum class SslMode {
     ALLOW,
     DISABLE,
@@ -75,6 +81,7 @@ public:
     Builder& passfile(std::string const& val);
     Builder& password(std::string const& val);
     Builder& port(int val);
+    Builder& replication(ReplicationMode val);
     Builder& requirepeer(std::string const& val);
     Builder& requiressl(bool val);
     Builder& service(std::string const& val);
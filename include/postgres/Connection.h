@@ -1,22 +1,29 @@
 #pragma once
 
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 #include <libpq-fe.h>
 #include <postgres/Command.h>
+#include <postgres/Consumer.h>
+#include <postgres/Error.h>
+#include <postgres/Replication.h>
 #include <postgres/Result.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Row.h>
 #include <postgres/Statement.h>
+#include <postgres/Stream.h>
 #include <postgres/Transaction.h>
 
 namespace postgres {
 
 class Config;
-class Consumer;
 class PreparedCommand;
 class Receiver;
 struct PrepareData;
@@ -56,6 +63,34 @@ public:
         return exec(Command{RangeStatement::insert(it, end), std::make_pair(it, end)});
     }
 
+    template <typename T>
+    Result insertReturning(T& val) {
+        return insertReturning(&val, &val + 1);
+    }
+
+    // Generated values are written back to the objects row by row, assuming the rows
+    // come back in the order of VALUES, which PostgreSQL does not promise.
+    template <typename Iter>
+    Result insertReturning(Iter const it, Iter const end) {
+        auto const count = std::distance(it, end);
+        _POSTGRES_CXX_ASSERT(LogicError, 0 < count, "nothing to insert");
+
+        auto res = exec(Command{RangeStatement::insertReturning(it, end),
+                                internal::InsertRange<Iter>{it, end}});
+        if (!res.isOk()) {
+            return res;
+        }
+
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             res.size() == count,
+                             "bad number of returned rows: " << res.size() << " of " << count);
+        auto dst = it;
+        for (auto row : res) {
+            row >> internal::deref(*dst++);
+        }
+        return res;
+    }
+
     template <typename T>
     Status update(T const& val) {
         return exec(Command{Statement<T>::update(), val});
@@ -76,12 +111,46 @@ public:
         return res;
     }
 
+    // Statements are sent along with BEGIN and COMMIT in a single round trip
+    // if libpq supports pipelining. The result of the last one is returned.
     template <typename... Ts>
     std::enable_if_t<(1 < sizeof... (Ts)), Result> transact(Ts&& ... args) {
+#ifdef LIBPQ_HAS_PIPELINING
+        return pipeline([&] {
+            (enqueue(std::forward<Ts>(args)), ...);
+        });
+#else
         auto tx  = begin();
         auto res = exec(std::forward<Ts>(args)...);
         tx.commit();
         return res;
+#endif
+    }
+
+    // Runs the function in a transaction, replaying the whole of it
+    // if the transaction fails in a way the policy allows to retry.
+    template <typename F>
+    std::invoke_result_t<F&, Connection&> retryTransaction(F&& func,
+                                                           RetryPolicy const& policy = RetryPolicy{}) {
+        for (auto attempt = 1;; ++attempt) {
+            try {
+                auto tx = begin(policy.isolation(), policy.isReadOnly());
+                if constexpr (std::is_void_v<std::invoke_result_t<F&, Connection&>>) {
+                    func(*this);
+                    tx.commit();
+                    return;
+                } else {
+                    auto res = func(*this);
+                    tx.commit();
+                    return res;
+                }
+            } catch (SqlError const& e) {
+                if ((policy.attempts() <= attempt) || !policy.isRetryable(e.sqlState())) {
+                    throw;
+                }
+            }
+            std::this_thread::sleep_for(policy.delay(attempt));
+        }
     }
 
     Result exec(PrepareData const& prep);
@@ -97,7 +166,27 @@ public:
     Receiver iter(Command const& cmd);
     Receiver iter(PreparedCommand const& cmd);
 
+    // Rows are received in chunks either natively, if supported by libpq,
+    // or by fetching from a cursor. In the latter case a transaction is started
+    // unless one is already in progress, and committed once the stream is destroyed.
+    Stream stream(Command const& cmd, int chunk_size = 1000);
+
+    // Fetches rows from a cursor in batches keeping the next batch request in flight
+    // while the current one is processed. With a memory limit the first batch is a single row,
+    // then the batch size is adjusted to fit two batches in the limit as measured
+    // on the previous one. A transaction is managed the same way as for streams above.
+    Stream cursor(Command const& cmd, int batch_size = 10000, size_t max_memory = 0);
+
     Transaction begin();
+    Transaction begin(IsolationLevel level, bool is_read_only = false);
+
+    // Applies to consumers and receivers created afterwards.
+    void abandonPolicy(AbandonPolicy val);
+
+    // Requires a connection in the logical replication mode.
+    ReplicationStream replicate(std::string const& slot,
+                                std::vector<std::string> const& publications,
+                                Lsn start = 0);
 
     bool reset();
     bool isOk();
@@ -121,10 +210,22 @@ private:
         return exec(std::forward<Ts>(args)...);
     };
 
+#ifdef LIBPQ_HAS_PIPELINING
+    // Wraps the queued statements in a transaction, rolled back if any of them fails.
+    Result pipeline(std::function<void()> const& queue);
+    void enqueue(PrepareData const& prep);
+    void enqueue(Command const& cmd);
+    void enqueue(PreparedCommand const& cmd);
+#endif
+
+    static std::string makeCursorName();
+    std::function<void()> declare(Command const& cmd, std::string const& name);
+
     template <typename F>
     std::string doEsc(std::string const& in, F f);
 
     std::shared_ptr<PGconn> handle_;
+    AbandonPolicy           abandon_ = AbandonPolicy::DRAIN;
 };
 
 }  // namespace postgres
@@ -7,6 +7,14 @@ namespace postgres {
 
 class Status;
 
+// Regulates what to do with the rest of results when a consumer is destroyed.
+enum class AbandonPolicy {
+    // Receive and discard all of them.
+    DRAIN,
+    // Ask the server to cancel the statement first, if it is still in progress.
+    CANCEL,
+};
+
 class Consumer {
 public:
     Consumer(Consumer const& other) = delete;
@@ -19,13 +27,19 @@ public:
     bool isOk() const;
     bool isBusy();
 
+    // Requests the server to abandon processing of the statement.
+    // Results are still to be consumed, the last one reporting an error
+    // unless the statement has already completed. Returns false if the request has failed.
+    bool cancel();
+
 protected:
     friend class Connection;
 
-    explicit Consumer(std::shared_ptr<PGconn> handle, int is_ok);
+    explicit Consumer(std::shared_ptr<PGconn> handle, int is_ok, AbandonPolicy abandon);
 
     std::shared_ptr<PGconn> handle_;
-    bool                    is_ok_ = false;
+    bool                    is_ok_   = false;
+    AbandonPolicy           abandon_ = AbandonPolicy::DRAIN;
 };
 
 }  // namespace postgres
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <chrono>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 #include <postgres/Config.h>
+#include <postgres/Consumer.h>
+#include <postgres/FlowConfig.h>
 #include <postgres/PrepareData.h>
+#include <postgres/Priority.h>
 
 namespace postgres {
 
+class Cache;
 class Connection;
 
 enum class ShutdownPolicy {
@@ -17,6 +22,14 @@ enum class ShutdownPolicy {
     ABORT,
 };
 
+// Regulates the order in which queued jobs are started.
+enum class QueuePolicy {
+    // First in, first out.
+    FIFO,
+    // Jobs with an earlier deadline first, the ones without a deadline last.
+    EARLIEST_DEADLINE,
+};
+
 class Context {
 public:
     class Builder;
@@ -31,18 +44,53 @@ public:
 
     Connection connect() const;
     Duration idleTimeout() const;
+    Duration maxLifetime() const;
+    Duration validationInterval() const;
     int maxConcurrency() const;
+    int minConcurrency() const;
+    Duration targetWait() const;
+    Duration scalingInterval() const;
+    int maxConnecting() const;
+    Duration minBackoff() const;
+    Duration maxBackoff() const;
+    int maxConnectAttempts() const;
     int maxQueueSize() const;
+    int maxQueueSize(Priority prio) const;
+    Duration agingInterval() const;
+    int lowWatermark() const;
+    int highWatermark() const;
     ShutdownPolicy shutdownPolicy() const;
+    AbandonPolicy abandonPolicy() const;
+    QueuePolicy queuePolicy() const;
+    FlowConfig const& flow(std::string const& id) const;
+    std::shared_ptr<Cache> cache() const;
 
 private:
-    Config                   cfg_;
-    std::string              uri_;
-    std::vector<PrepareData> preparings_;
-    Duration                 max_idle_;
-    int                      max_concur_;
-    int                      max_queue_;
-    ShutdownPolicy           shut_pol_;
+    Config                            cfg_;
+    std::string                       uri_;
+    std::vector<PrepareData>          preparings_;
+    Duration                          max_idle_;
+    Duration                          max_life_;
+    Duration                          validation_;
+    int                               max_concur_;
+    int                               min_concur_;
+    Duration                          target_wait_;
+    Duration                          scaling_;
+    int                               max_connecting_;
+    Duration                          min_backoff_;
+    Duration                          max_backoff_;
+    int                               max_attempts_;
+    int                               max_queue_;
+    std::map<Priority, int>           max_lanes_;
+    Duration                          aging_;
+    int                               low_mark_;
+    int                               high_mark_;
+    ShutdownPolicy                    shut_pol_;
+    AbandonPolicy                     abandon_pol_;
+    QueuePolicy                       queue_pol_;
+    std::map<std::string, FlowConfig> flows_;
+    FlowConfig                        default_flow_;
+    std::shared_ptr<Cache>            cache_;
 };
 
 class Context::Builder {
@@ -58,14 +106,44 @@ public:
     Builder& uri(std::string uri);
     Builder& prepare(PrepareData prep);
     Builder& idleTimeout(Context::Duration val);
+    // Connections older than that are replaced once their current job is over.
+    Builder& maxLifetime(Context::Duration val);
+    // Idle connections are checked with a round trip to the server that often.
+    Builder& validationInterval(Context::Duration val);
     Builder& maxConcurrency(int val);
+    // Number of connections kept open once established, despite the idle timeout.
+    Builder& minConcurrency(int val);
+    // The pool grows only when jobs wait in the queue longer than that on average.
+    Builder& targetWait(Context::Duration val);
+    // Minimal interval between two connections opened to grow the pool.
+    Builder& scalingInterval(Context::Duration val);
+    // Number of connections allowed to be established at the same time.
+    Builder& maxConnecting(int val);
+    // Bounds of the delay between attempts to connect after a failure,
+    // doubled with every consecutive failure.
+    Builder& connectBackoff(Context::Duration min, Context::Duration max);
+    // Failures to connect in a row, with no connection left in the pool,
+    // after which the queued jobs fail with the error. Zero keeps them waiting.
+    Builder& maxConnectAttempts(int val);
     Builder& maxQueueSize(int val);
+    Builder& maxQueueSize(Priority prio, int val);
+    Builder& agingInterval(Context::Duration val);
+    // Queue depths at which the queue is reported as congested and as relieved.
+    Builder& watermarks(int low, int high);
     Builder& shutdownPolicy(ShutdownPolicy val);
+    Builder& abandonPolicy(AbandonPolicy val);
+    Builder& queuePolicy(QueuePolicy val);
+    Builder& flow(std::string id, FlowConfig cfg);
+    // Applies to each of the flows not configured explicitly.
+    Builder& defaultFlow(FlowConfig cfg);
+    Builder& cache(std::shared_ptr<Cache> val);
 
     Context build();
     std::shared_ptr<Context> share();
 
 private:
+    static void validate(FlowConfig const& cfg);
+
     Context ctx_;
 };
 
@@ -41,6 +41,34 @@ public:
     ~RuntimeError() noexcept override;
 };
 
+// Statement is failed, the server tells why with a SQLSTATE code.
+// The code is empty for errors detected by the client, e.g. a lost connection.
+class SqlError : public RuntimeError {
+public:
+    explicit SqlError(std::string msg, std::string state);
+    SqlError(SqlError const& other);
+    SqlError& operator=(SqlError const& other);
+    SqlError(SqlError&& other) noexcept;
+    SqlError& operator=(SqlError&& other) noexcept;
+    ~SqlError() noexcept override;
+
+    std::string const& sqlState() const;
+
+private:
+    std::string state_;
+};
+
+// Job deadline is passed either in the queue or while executing.
+class TimeoutError : public RuntimeError {
+public:
+    explicit TimeoutError(std::string msg);
+    TimeoutError(TimeoutError const& other);
+    TimeoutError& operator=(TimeoutError const& other);
+    TimeoutError(TimeoutError&& other) noexcept;
+    TimeoutError& operator=(TimeoutError&& other) noexcept;
+    ~TimeoutError() noexcept override;
+};
+
 }  // namespace postgres
 
 #define _POSTGRES_CXX_FAIL(T, msg) \
@@ -0,0 +1,13 @@
+#pragma once
+
+namespace postgres {
+
+// Mechanisms a single thread waits on sockets of many connections with.
+enum class EventBackend {
+    EPOLL,
+    // Submits and reaps a batch of socket polls per system call.
+    // Falls back to epoll if the kernel doesn't allow io_uring.
+    IO_URING,
+};
+
+}  // namespace postgres
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace postgres {
+
+// Scheduling parameters of a flow of jobs, e.g. of a single tenant.
+struct FlowConfig {
+    // Share of the pool relative to other flows with waiting jobs.
+    int    weight          = 1;
+    // Jobs admitted per second on average, unlimited if zero.
+    double rate            = 0.0;
+    // Jobs admitted at once in excess of the rate.
+    int    burst           = 1;
+    // Jobs of the flow executed at the same time, unlimited if zero.
+    int    max_concurrency = 0;
+};
+
+}  // namespace postgres
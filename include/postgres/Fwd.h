@@ -2,6 +2,8 @@
 
 namespace postgres {
 
+class Cache;
+class Change;
 class Client;
 class Command;
 class Config;
@@ -10,15 +12,25 @@ class Consumer;
 class Context;
 class Error;
 class Field;
+template <typename T, typename Key>
+class Loader;
 class LogicError;
 class PreparedCommand;
 class Receiver;
+class ReplicationStream;
 class Result;
 class Row;
 class RuntimeError;
+class SharedConnection;
 class Status;
+class Stream;
+class Subscriber;
 class Time;
 class Transaction;
+class Tuple;
+struct Column;
+struct Notification;
 struct PrepareData;
+struct Relation;
 
 }  // namespace postgres
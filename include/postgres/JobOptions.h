@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <postgres/Priority.h>
+
+namespace postgres {
+
+// Scheduling parameters of a job submitted to a client.
+class JobOptions {
+public:
+    using Duration = std::chrono::high_resolution_clock::duration;
+
+    explicit JobOptions();
+    JobOptions(JobOptions const& other);
+    JobOptions& operator=(JobOptions const& other);
+    JobOptions(JobOptions&& other) noexcept;
+    JobOptions& operator=(JobOptions&& other) noexcept;
+    ~JobOptions() noexcept;
+
+    JobOptions& priority(Priority val);
+    JobOptions& timeout(Duration val);
+    // Jobs of different flows are given fair shares of the pool.
+    JobOptions& flow(std::string val);
+    // Wait for room in a full queue up to the duration instead of failing at once.
+    // Duration::max() means waiting as long as it takes.
+    JobOptions& block(Duration val);
+    // Marks the job idempotent, letting it be retried on another connection
+    // up to the number of times if the one it has run on is lost.
+    JobOptions& retries(int val);
+
+    Priority priority() const;
+    std::optional<Duration> const& timeout() const;
+    std::string const& flow() const;
+    std::optional<Duration> const& block() const;
+    int retries() const;
+
+private:
+    Priority                prio_;
+    std::optional<Duration> timeout_;
+    std::string             flow_;
+    std::optional<Duration> block_;
+    int                     retries_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <postgres/Client.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Result.h>
+#include <postgres/Row.h>
+
+namespace postgres {
+
+// Collects keys requested concurrently and looks them all up with a single statement.
+// The statement must accept an array of keys as its only argument,
+// e.g. "SELECT id, info FROM my_table WHERE id = ANY($1)".
+// Batches are submitted to the client from the loader's own thread.
+template <typename T, typename Key>
+class Loader {
+public:
+    using Clock    = std::chrono::high_resolution_clock;
+    using Duration = Clock::duration;
+
+    explicit Loader(Client& client,
+                    std::string stmt,
+                    std::string key_col,
+                    Duration const window = std::chrono::milliseconds{1},
+                    int const max_batch = 1000)
+        : client_{&client},
+          stmt_{std::make_shared<std::string const>(std::move(stmt))},
+          key_col_{std::make_shared<std::string const>(std::move(key_col))},
+          window_{window},
+          max_batch_{max_batch} {
+        _POSTGRES_CXX_ASSERT(LogicError, 0 <= window_.count(), "bad window: " << window_.count());
+        _POSTGRES_CXX_ASSERT(LogicError, 1 <= max_batch_, "bad batch size: " << max_batch_);
+        thread_ = std::thread([this] {
+            run();
+        });
+    }
+
+    Loader(Loader const& other) = delete;
+    Loader& operator=(Loader const& other) = delete;
+    Loader(Loader&& other) noexcept = delete;
+    Loader& operator=(Loader&& other) noexcept = delete;
+
+    // Pending keys are still looked up before the loader stops.
+    ~Loader() noexcept {
+        {
+            std::lock_guard guard{mtx_};
+            is_stopped_ = true;
+        }
+        signal_.notify_one();
+        thread_.join();
+    }
+
+    // Resolves to all the rows having the given key, possibly none.
+    std::future<std::vector<T>> load(Key key) {
+        std::promise<std::vector<T>> prom{};
+        auto                         res = prom.get_future();
+
+        std::lock_guard guard{mtx_};
+        if (pending_.empty()) {
+            since_ = Clock::now();
+        }
+        pending_[std::move(key)].push_back(std::move(prom));
+        if (static_cast<int>(pending_.size()) == max_batch_) {
+            signal_.notify_one();
+        }
+        return res;
+    }
+
+private:
+    using Batch = std::map<Key, std::vector<std::promise<std::vector<T>>>>;
+
+    void run() {
+        std::unique_lock guard{mtx_};
+        while (true) {
+            signal_.wait(guard, [this] {
+                return is_stopped_ || !pending_.empty();
+            });
+            if (pending_.empty()) {
+                break;
+            }
+
+            signal_.wait_until(guard, since_ + window_, [this] {
+                return is_stopped_ || (max_batch_ <= static_cast<int>(pending_.size()));
+            });
+            auto batch = std::make_shared<Batch>(std::move(pending_));
+            pending_.clear();
+
+            guard.unlock();
+            flush(std::move(batch));
+            guard.lock();
+        }
+    }
+
+    void flush(std::shared_ptr<Batch> batch) {
+        try {
+            client_->query([stmt = stmt_, key_col = key_col_, batch](Connection& conn) {
+                try {
+                    return fetch(conn, *stmt, *key_col, *batch);
+                } catch (...) {
+                    fail(*batch, std::current_exception());
+                    throw;
+                }
+            });
+        } catch (...) {
+            fail(*batch, std::current_exception());
+        }
+    }
+
+    static Result fetch(Connection& conn,
+                        std::string const& stmt,
+                        std::string const& key_col,
+                        Batch& batch) {
+        std::vector<Key> keys{};
+        keys.reserve(batch.size());
+        for (auto const& item : batch) {
+            keys.push_back(item.first);
+        }
+
+        auto                          res = conn.exec(Command{stmt, keys});
+        std::map<Key, std::vector<T>> found{};
+        for (auto row : res) {
+            auto& vals = found[row[key_col].template as<Key>()];
+            vals.emplace_back();
+            row >> vals.back();
+        }
+
+        for (auto& [key, proms] : batch) {
+            auto& vals = found[key];
+            for (auto& prom : proms) {
+                prom.set_value(vals);
+            }
+        }
+        return res;
+    }
+
+    static void fail(Batch& batch, std::exception_ptr const& err) {
+        for (auto& item : batch) {
+            for (auto& prom : item.second) {
+                try {
+                    prom.set_exception(err);
+                } catch (std::future_error const&) {
+                    // Already satisfied.
+                }
+            }
+        }
+    }
+
+    Client*                            client_;
+    std::shared_ptr<std::string const> stmt_;
+    std::shared_ptr<std::string const> key_col_;
+    Duration                           window_;
+    int                                max_batch_;
+    Batch                              pending_;
+    Clock::time_point                  since_;
+    bool                               is_stopped_ = false;
+    std::condition_variable            signal_;
+    std::mutex                         mtx_;
+    std::thread                        thread_;
+};
+
+}  // namespace postgres
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <string>
+
+namespace postgres {
+
+struct Notification {
+    std::string channel;
+    std::string payload;
+    int         pid = 0;
+};
+
+}  // namespace postgres
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <postgres/Cache.h>
 #include <postgres/Client.h>
 #include <postgres/Command.h>
 #include <postgres/Config.h>
@@ -7,15 +8,28 @@
 #include <postgres/Consumer.h>
 #include <postgres/Context.h>
 #include <postgres/Error.h>
+#include <postgres/EventBackend.h>
 #include <postgres/Field.h>
+#include <postgres/FlowConfig.h>
+#include <postgres/JobOptions.h>
+#include <postgres/Loader.h>
+#include <postgres/Notification.h>
 #include <postgres/Oid.h>
 #include <postgres/PreparedCommand.h>
 #include <postgres/PrepareData.h>
+#include <postgres/Priority.h>
+#include <postgres/QueueStats.h>
 #include <postgres/Receiver.h>
+#include <postgres/Replication.h>
 #include <postgres/Result.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Row.h>
+#include <postgres/SharedConnection.h>
 #include <postgres/Statement.h>
 #include <postgres/Status.h>
+#include <postgres/Stream.h>
+#include <postgres/Subscriber.h>
 #include <postgres/Time.h>
 #include <postgres/Transaction.h>
+#include <postgres/Tuple.h>
 #include <postgres/Visitable.h>
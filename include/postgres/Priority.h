@@ -0,0 +1,12 @@
+#pragma once
+
+namespace postgres {
+
+// Lanes of a connection pool queue, from the most urgent to the least one.
+enum class Priority {
+    INTERACTIVE,
+    NORMAL,
+    BULK,
+};
+
+}  // namespace postgres
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace postgres {
+
+// Admission statistics of a connection pool queue.
+struct QueueStats {
+    // Jobs either queued or passed to an idle worker directly.
+    uint64_t accepted     = 0;
+    // Jobs refused due to the queue overflow or rate limits.
+    uint64_t rejected     = 0;
+    // Jobs dropped from the queue after their deadline.
+    uint64_t expired      = 0;
+    // Jobs waiting in the queue at the moment.
+    size_t   size         = 0;
+    // Whether the queue has reached the high watermark and not drained to the low one since.
+    bool     is_congested = false;
+};
+
+}  // namespace postgres
@@ -22,7 +22,7 @@ public:
 private:
     friend class Connection;
 
-    explicit Receiver(std::shared_ptr<PGconn> handle, int is_ok);
+    explicit Receiver(std::shared_ptr<PGconn> handle, int is_ok, AbandonPolicy abandon);
 
     void iter();
 };
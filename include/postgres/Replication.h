@@ -0,0 +1,123 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <libpq-fe.h>
+#include <postgres/Time.h>
+#include <postgres/Tuple.h>
+
+namespace postgres::internal {
+
+class LogicalDecoder;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+// Write-ahead log position.
+using Lsn = uint64_t;
+
+std::string formatLsn(Lsn lsn);
+
+enum class ChangeType {
+    BEGIN,
+    RELATION,
+    INSERT,
+    UPDATE,
+    DELETE,
+    COMMIT,
+};
+
+class Change {
+public:
+    Change(Change const& other);
+    Change& operator=(Change const& other);
+    Change(Change&& other) noexcept;
+    Change& operator=(Change&& other) noexcept;
+    ~Change() noexcept;
+
+    template <typename T>
+    bool is() const {
+        return relation_ && relation_->is<T>();
+    }
+
+    template <typename T>
+    Change const& operator>>(T& val) const {
+        tuple() >> val;
+        return *this;
+    }
+
+    ChangeType type() const;
+
+    // Position to acknowledge once the change is applied.
+    // Commits carry the end of the transaction.
+    Lsn lsn() const;
+    uint32_t xid() const;
+    Time::Point time() const;
+
+    Relation const& relation() const;
+
+    // New row of inserts and updates, old row or its key of deletes.
+    Tuple const& tuple() const;
+
+    // Old row or its key of updates, depending on the replica identity of the table.
+    std::optional<Tuple> const& old() const;
+
+private:
+    friend class internal::LogicalDecoder;
+
+    explicit Change(ChangeType type, Lsn lsn);
+
+    ChangeType                      type_;
+    Lsn                             lsn_  = 0;
+    uint32_t                        xid_  = 0;
+    Time::Point                     time_ = Time::EPOCH;
+    std::shared_ptr<Relation const> relation_;
+    std::optional<Tuple>            tuple_;
+    std::optional<Tuple>            old_;
+};
+
+// Streams changes from a logical replication slot using the pgoutput plugin.
+// Standby status updates are sent from within next() periodically
+// and whenever the server asks for them.
+class ReplicationStream {
+public:
+    using Duration = std::chrono::high_resolution_clock::duration;
+
+    ReplicationStream(ReplicationStream const& other) = delete;
+    ReplicationStream& operator=(ReplicationStream const& other) = delete;
+    ReplicationStream(ReplicationStream&& other) noexcept;
+    ReplicationStream& operator=(ReplicationStream&& other) noexcept;
+    ~ReplicationStream() noexcept;
+
+    // Returns nothing if no change arrived in time.
+    std::optional<Change> next(Duration timeout);
+
+    // Let the server discard the log up to the position.
+    void acknowledge(Lsn lsn);
+    void feedbackInterval(Duration val);
+
+    Lsn received() const;
+    Lsn acknowledged() const;
+
+private:
+    friend class Connection;
+
+    explicit ReplicationStream(std::shared_ptr<PGconn> handle, PGresult* res);
+
+    std::optional<Change> receive(char const* data, int len);
+    void feedback(bool is_forced);
+    void wait(Duration timeout);
+
+    std::shared_ptr<PGconn>                  handle_;
+    std::unique_ptr<internal::LogicalDecoder> decoder_;
+    Lsn                                      received_     = 0;
+    Lsn                                      acknowledged_ = 0;
+    Duration                                 interval_;
+    std::chrono::steady_clock::time_point    last_feedback_;
+};
+
+}  // namespace postgres
@@ -2,6 +2,12 @@
 
 #include <postgres/Status.h>
 
+namespace postgres::internal {
+
+class Multiplexer;
+
+}  // namespace postgres::internal
+
 namespace postgres {
 
 class Row;
@@ -23,6 +29,7 @@ public:
 private:
     friend class Connection;
     friend class Receiver;
+    friend class internal::Multiplexer;
 
     explicit Result(PGresult* handle);
     explicit Result(PGresult* handle, Consumer* consumer);
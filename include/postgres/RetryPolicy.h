@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace postgres {
+
+enum class IsolationLevel {
+    // The one set up for the session.
+    DEFAULT,
+    READ_COMMITTED,
+    REPEATABLE_READ,
+    SERIALIZABLE,
+};
+
+// Regulates how a transaction is started and replayed on transient failures.
+// By default serialization failures (40001) and deadlocks (40P01) are retried.
+class RetryPolicy {
+public:
+    using Duration = std::chrono::high_resolution_clock::duration;
+
+    explicit RetryPolicy();
+    RetryPolicy(RetryPolicy const& other);
+    RetryPolicy& operator=(RetryPolicy const& other);
+    RetryPolicy(RetryPolicy&& other) noexcept;
+    RetryPolicy& operator=(RetryPolicy&& other) noexcept;
+    ~RetryPolicy() noexcept;
+
+    // Total number of runs including the first one.
+    RetryPolicy& attempts(int val);
+    // Bounds of the delay between attempts, doubled with every attempt and jittered.
+    RetryPolicy& backoff(Duration min, Duration max);
+    RetryPolicy& isolation(IsolationLevel val);
+    RetryPolicy& readOnly(bool val);
+    // Adds a SQLSTATE code to retry on.
+    RetryPolicy& retryOn(std::string state);
+
+    int attempts() const;
+    IsolationLevel isolation() const;
+    bool isReadOnly() const;
+    bool isRetryable(std::string const& state) const;
+    // Delay before the next attempt after the given number of failed ones.
+    Duration delay(int failures) const;
+
+private:
+    int                      attempts_;
+    Duration                 min_backoff_;
+    Duration                 max_backoff_;
+    IsolationLevel           isolation_;
+    bool                     is_read_only_;
+    std::vector<std::string> states_;
+};
+
+}  // namespace postgres
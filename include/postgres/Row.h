@@ -30,7 +30,7 @@ public:
 
     template <typename T>
     void accept(char const* const name, T& val) {
-        (*this)[name] >> val;
+        Field{*res_, row_idx_, find(name)} >> val;
     };
 
     Field operator[](std::string const& col_name) const;
@@ -44,9 +44,14 @@ private:
 
     explicit Row(PGresult& res, int row_idx);
 
+    // Fields are usually visited in the order of columns,
+    // so the one next to the previously found is checked before searching.
+    int find(char const* name);
+
     PGresult* res_;
     int row_idx_;
     int col_idx_;
+    int hint_ = 0;
 };
 
 }  // namespace postgres
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+#include <postgres/EventBackend.h>
+#include <postgres/PrepareData.h>
+#include <postgres/Result.h>
+
+namespace postgres::internal {
+
+class Multiplexer;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+class Command;
+class Config;
+class Connection;
+class PreparedCommand;
+
+// A connection which many threads may execute statements on concurrently.
+// Statements are pipelined onto the socket in the order of submission
+// and every caller gets the result of its own statement.
+// Each statement is a separate transaction, since statements of different callers interleave.
+// The connection is not restored on loss: all the statements in progress fail,
+// as well as the ones submitted later.
+//
+// The builder allows to spread statements over several connections,
+// all of them driven by the same background thread.
+class SharedConnection {
+public:
+    class Builder;
+
+    explicit SharedConnection();
+    explicit SharedConnection(Config const& cfg);
+    explicit SharedConnection(std::string const& uri);
+    SharedConnection(SharedConnection const& other) = delete;
+    SharedConnection& operator=(SharedConnection const& other) = delete;
+    SharedConnection(SharedConnection&& other) noexcept;
+    SharedConnection& operator=(SharedConnection&& other) noexcept;
+    // Waits for the statements already submitted to complete.
+    ~SharedConnection() noexcept;
+
+    // Only one of the connections gets the statement prepared,
+    // use the builder to prepare statements on all of them.
+    std::future<Result> exec(PrepareData prep);
+    std::future<Result> exec(Command cmd);
+    std::future<Result> exec(PreparedCommand cmd);
+
+    // False once all the connections are lost.
+    bool isOk();
+    // The one actually in use, which may differ from the requested one.
+    EventBackend backend() const;
+
+private:
+    explicit SharedConnection(std::function<Connection()> const& connect,
+                              int connections,
+                              EventBackend backend);
+
+    std::unique_ptr<internal::Multiplexer> mux_;
+};
+
+class SharedConnection::Builder {
+public:
+    explicit Builder();
+    Builder(Builder const& other) = delete;
+    Builder& operator=(Builder const& other) = delete;
+    Builder(Builder&& other) noexcept;
+    Builder& operator=(Builder&& other) noexcept;
+    ~Builder() noexcept;
+
+    Builder& config(Config cfg);
+    Builder& uri(std::string uri);
+    Builder& connections(int val);
+    Builder& backend(EventBackend val);
+    // Prepares the statement on every connection once it is established.
+    Builder& prepare(PrepareData prep);
+
+    SharedConnection build();
+
+private:
+    std::function<Connection()> connect_;
+    int                         connections_ = 1;
+    EventBackend                backend_     = EventBackend::EPOLL;
+    std::vector<PrepareData>    preps_;
+};
+
+}  // namespace postgres
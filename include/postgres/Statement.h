@@ -1,5 +1,6 @@
 #pragma once
 
+#include <iterator>
 #include <string>
 #include <type_traits>
 #include <postgres/internal/Visitors.h>
@@ -82,6 +83,21 @@ struct RangeStatement {
                + placeholders(beg, end);
     }
 
+    // Generated fields get their default values, then all the fields are returned back.
+    template <typename Iter>
+    static std::string insertReturning(Iter const beg, Iter const end) {
+        using T = std::remove_pointer_t<typename std::iterator_traits<Iter>::value_type>;
+        using S = Statement<T>;
+        return "INSERT INTO "
+               + std::string{S::table()}
+               + " ("
+               + S::fields()
+               + ") VALUES "
+               + values(beg, end)
+               + " RETURNING "
+               + S::fields();
+    }
+
     template <typename Iter>
     static std::string placeholders(Iter const beg, Iter const end, int const offset = 0) {
         using T = std::remove_pointer_t<typename Iter::value_type>;
@@ -97,6 +113,22 @@ struct RangeStatement {
         }
         return res;
     }
+
+    template <typename Iter>
+    static std::string values(Iter const beg, Iter const end, int const offset = 0) {
+        using T = std::remove_pointer_t<typename std::iterator_traits<Iter>::value_type>;
+        internal::ValuesCollector coll{offset, {}};
+        std::string               res{};
+
+        for (auto it = beg; it != end; ++it) {
+            T::visitPostgresDefinition(coll);
+            res += res.empty() ? "(" : ",(";
+            res += coll.res;
+            res += ")";
+            coll.res.clear();
+        }
+        return res;
+    }
 };
 
 }  // namespace postgres
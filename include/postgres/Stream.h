@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <postgres/Result.h>
+#include <postgres/Row.h>
+
+namespace postgres {
+
+// Iterates over rows of a query received in chunks of limited size,
+// so that memory consumption stays bounded regardless of the result size.
+// Rows are only valid until the iterator is incremented.
+class Stream {
+public:
+    class iterator;
+
+    Stream(Stream const& other) = delete;
+    Stream& operator=(Stream const& other) = delete;
+    Stream(Stream&& other) noexcept;
+    Stream& operator=(Stream&& other) noexcept;
+    ~Stream() noexcept;
+
+    iterator begin();
+    iterator end();
+
+    // Empty when the stream is over.
+    Result const& chunk();
+    bool next();
+
+    // Moves the current chunk out, so the next call returns the following one.
+    Result take();
+
+private:
+    friend class Client;
+    friend class Connection;
+
+    explicit Stream(std::function<Result()> fetch, std::function<void()> close);
+
+    std::function<Result()> fetch_;
+    std::function<void()>   close_;
+    std::optional<Result>   chunk_;
+    int                     idx_ = 0;
+};
+
+class Stream::iterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = Row;
+    using pointer = Row*;
+    using reference = Row&;
+
+    iterator(iterator const& other);
+    iterator& operator=(iterator const& other);
+    iterator(iterator&& other) noexcept;
+    iterator& operator=(iterator&& other) noexcept;
+    ~iterator() noexcept;
+
+    bool operator==(iterator const& other) const;
+    bool operator!=(iterator const& other) const;
+    void operator++();
+    Row operator->() const;
+    Row operator*() const;
+
+private:
+    friend class Stream;
+
+    explicit iterator(Stream* stream);
+
+    Stream* stream_ = nullptr;
+};
+
+}  // namespace postgres
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <postgres/Notification.h>
+
+namespace postgres::internal {
+
+class Listener;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+class Config;
+class Connection;
+
+// Receives asynchronous notifications on a dedicated connection.
+// The connection socket is waited on in a background thread, so payloads are delivered
+// as soon as they arrive. The connection is restored automatically on loss
+// and all the subscribed channels are listened again.
+class Subscriber {
+public:
+    class Builder;
+    using Callback = std::function<void(Notification const&)>;
+    using Executor = std::function<void(std::function<void()>)>;
+
+    Subscriber(Subscriber const& other) = delete;
+    Subscriber& operator=(Subscriber const& other) = delete;
+    Subscriber(Subscriber&& other) noexcept;
+    Subscriber& operator=(Subscriber&& other) noexcept;
+    ~Subscriber() noexcept;
+
+    // Several callbacks may be subscribed to the same channel.
+    void subscribe(std::string const& channel, Callback callback);
+    void unsubscribe(std::string const& channel);
+
+private:
+    struct Handlers;
+
+    explicit Subscriber(std::function<Connection()> connect, std::shared_ptr<Handlers> handlers);
+
+    std::shared_ptr<Handlers>           handlers_;
+    std::unique_ptr<internal::Listener> listener_;
+};
+
+class Subscriber::Builder {
+public:
+    explicit Builder();
+    Builder(Builder const& other) = delete;
+    Builder& operator=(Builder const& other) = delete;
+    Builder(Builder&& other) noexcept;
+    Builder& operator=(Builder&& other) noexcept;
+    ~Builder() noexcept;
+
+    Builder& config(Config cfg);
+    Builder& uri(std::string uri);
+
+    // Callbacks are invoked on the listening thread unless an executor is set.
+    // Exceptions thrown by either callbacks or the executor are ignored.
+    Builder& executor(Executor val);
+
+    // Invoked each time the connection is established, including the first one.
+    // Notifications sent while the connection was lost are missing.
+    Builder& onReset(std::function<void()> val);
+
+    Subscriber build();
+
+private:
+    std::function<Connection()> connect_;
+    std::shared_ptr<Handlers>   handlers_;
+};
+
+}  // namespace postgres
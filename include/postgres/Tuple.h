@@ -0,0 +1,140 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <postgres/internal/Classifier.h>
+#include <postgres/Error.h>
+#include <postgres/Oid.h>
+#include <postgres/Statement.h>
+#include <postgres/Time.h>
+
+namespace postgres::internal {
+
+class LogicalDecoder;
+
+}  // namespace postgres::internal
+
+namespace postgres {
+
+struct Column {
+    std::string name;
+    Oid         type     = 0;
+    int32_t     modifier = -1;
+    bool        is_key   = false;
+};
+
+// Table description sent by the server ahead of the first change of the table.
+struct Relation {
+    Oid                 id       = 0;
+    std::string         schema;
+    std::string         name;
+    char                identity = 'd';
+    std::vector<Column> columns;
+
+    // The table name of T may be qualified with a schema.
+    template <typename T>
+    bool is() const {
+        auto const table = Statement<T>::table();
+        return (table == name) || (table == schema + "." + name);
+    }
+
+    int find(std::string_view col_name) const;
+};
+
+// Row values received via logical replication, which are always in text format.
+class Tuple {
+public:
+    Tuple(Tuple const& other);
+    Tuple& operator=(Tuple const& other);
+    Tuple(Tuple&& other) noexcept;
+    Tuple& operator=(Tuple&& other) noexcept;
+    ~Tuple() noexcept;
+
+    template <typename T>
+    std::enable_if_t<internal::isVisitable<T>(), Tuple const&> operator>>(T& val) const {
+        val.visitPostgresFields(*this);
+        return *this;
+    }
+
+    // Unchanged TOASTed values are not sent by the server,
+    // so the corresponding fields are left untouched.
+    template <typename T>
+    void accept(char const* const name, T& val) const {
+        auto const idx = relation_->find(name);
+        _POSTGRES_CXX_ASSERT(LogicError,
+                             0 <= idx,
+                             "no column '" << name << "' in relation '" << relation_->name << "'");
+        if (isUnchanged(idx)) {
+            return;
+        }
+        read(idx, val);
+    }
+
+    bool isNull(int idx) const;
+    bool isUnchanged(int idx) const;
+    std::string_view value(int idx) const;
+    int size() const;
+    Relation const& relation() const;
+
+private:
+    friend class internal::LogicalDecoder;
+
+    explicit Tuple(std::shared_ptr<Relation const> rel);
+
+    template <typename T>
+    void read(int const idx, T*& out) const {
+        if (isNull(idx)) {
+            out = nullptr;
+            return;
+        }
+        read(idx, *out);
+    }
+
+    template <typename T>
+    void read(int const idx, std::optional<T>& out) const {
+        if (isNull(idx)) {
+            out.reset();
+            return;
+        }
+        out.emplace();
+        read(idx, out.value());
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_arithmetic_v<T>> read(int const idx, T& out) const {
+        auto const val = text(idx);
+        if constexpr (std::is_same_v<T, bool>) {
+            out = (val == "t");
+            return;
+        } else {
+            auto const end = val.data() + val.size();
+            auto const res = std::from_chars(val.data(), end, out);
+            _POSTGRES_CXX_ASSERT(LogicError,
+                                 (res.ec == std::errc{}) && (res.ptr == end),
+                                 "cannot cast field '"
+                                     << relation_->columns[idx].name
+                                     << "' value '"
+                                     << val
+                                     << "' to desired arithmetic type");
+        }
+    }
+
+    void read(int idx, Time& out) const;
+    void read(int idx, Time::Point& out) const;
+    void read(int idx, std::string& out) const;
+    void read(int idx, std::string_view& out) const;
+
+    std::string_view text(int idx) const;
+
+    std::shared_ptr<Relation const> relation_;
+    std::vector<char>               kinds_;
+    std::vector<std::string>        values_;
+};
+
+}  // namespace postgres
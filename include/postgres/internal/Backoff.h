@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+#include <random>
+
+namespace postgres::internal {
+
+// Delay doubled with every consecutive failure within the bounds, the first one getting the minimum.
+// Jitter keeps the ones which have failed together from trying again all at once.
+std::chrono::nanoseconds backoff(std::chrono::nanoseconds min,
+                                 std::chrono::nanoseconds max,
+                                 int failures,
+                                 std::minstd_rand& rnd);
+
+}  // namespace postgres::internal
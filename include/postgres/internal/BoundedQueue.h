@@ -0,0 +1,95 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+// Hands items over from a single producer to a single consumer.
+// The producer blocks while the queue is full, the consumer blocks while it is empty.
+// Either side may close the queue to let the other one know it has gone.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(int const capacity)
+        : capacity_{capacity} {
+        _POSTGRES_CXX_ASSERT(LogicError, 1 <= capacity_, "bad queue capacity: " << capacity_);
+    }
+
+    BoundedQueue(BoundedQueue const& other) = delete;
+    BoundedQueue& operator=(BoundedQueue const& other) = delete;
+    BoundedQueue(BoundedQueue&& other) noexcept = delete;
+    BoundedQueue& operator=(BoundedQueue&& other) noexcept = delete;
+    ~BoundedQueue() noexcept = default;
+
+    // Returns false if the queue is closed.
+    bool push(T item) {
+        std::unique_lock guard{mtx_};
+        not_full_.wait(guard, [this] {
+            return is_closed_ || (static_cast<int>(items_.size()) < capacity_);
+        });
+        if (is_closed_) {
+            return false;
+        }
+
+        items_.push(std::move(item));
+        not_empty_.notify_one();
+        return true;
+    }
+
+    // Rethrows the error the producer has failed with, if any, after the items are over.
+    std::optional<T> pop() {
+        std::unique_lock guard{mtx_};
+        not_empty_.wait(guard, [this] {
+            return is_closed_ || !items_.empty();
+        });
+        if (items_.empty()) {
+            if (err_) {
+                std::rethrow_exception(err_);
+            }
+            return std::nullopt;
+        }
+
+        auto item = std::move(items_.front());
+        items_.pop();
+        not_full_.notify_one();
+        return item;
+    }
+
+    // Does nothing if the queue is already closed.
+    void fail(std::exception_ptr err) {
+        std::lock_guard guard{mtx_};
+        if (is_closed_) {
+            return;
+        }
+        err_ = std::move(err);
+        close(guard);
+    }
+
+    void close() {
+        std::lock_guard guard{mtx_};
+        close(guard);
+    }
+
+private:
+    void close(std::lock_guard<std::mutex> const&) {
+        is_closed_ = true;
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    int                     capacity_;
+    std::queue<T>           items_;
+    std::exception_ptr      err_;
+    bool                    is_closed_ = false;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::mutex              mtx_;
+};
+
+}  // namespace postgres::internal
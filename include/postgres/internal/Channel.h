@@ -1,10 +1,16 @@
 #pragma once
 
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <set>
+#include <string>
 #include <vector>
+#include <postgres/internal/Controller.h>
 #include <postgres/internal/IChannel.h>
 
 namespace postgres {
@@ -25,16 +31,92 @@ public:
     ~Channel() noexcept override;
 
     std::tuple<bool, Worker*> send(Job job) override;
+    std::optional<std::tuple<bool, Worker*>> trySend(Job job,
+                                                     Job::Clock::time_point until) override;
+    void retry(Job job) override;
     void receive(Slot& slot) override;
     void recycle(Worker& worker) override;
+    Job::Clock::duration fail(Worker& worker, Slot& slot, std::exception_ptr const& err) override;
     void drop() override;
     void quit(int count) override;
+    QueueStats stats() override;
 
 private:
-    std::tuple<bool, Worker*> send(Job job, int lim);
+    enum class Admission {
+        ACCEPTED,
+        FULL,
+        LIMITED,
+    };
+
+    struct Entry {
+        Job                    job;
+        Job::Clock::time_point queued;
+    };
+
+    // Jobs are ordered by the key, the ones with equal keys are kept in insertion order.
+    using Queue = std::multimap<Job::Clock::time_point, Entry>;
+
+    struct Flow {
+        Queue queue;
+        int   deficit = 0;
+    };
+
+    // Flows with waiting jobs take turns, being served by deficit round robin.
+    struct Lane {
+        std::map<std::string, Flow> flows;
+        std::deque<std::string>     turns;
+        size_t                      size = 0;
+    };
+
+    // State of a flow shared by all lanes.
+    struct Usage {
+        int                    running = 0;
+        double                 tokens  = 0.0;
+        Job::Clock::time_point refilled;
+    };
+
+    static constexpr auto LANES = static_cast<size_t>(Priority::BULK) + 1;
+    // Number of flows remembered before the ones at rest are looked for.
+    static constexpr size_t MIN_PRUNE = 64;
+
+    static void validate(Connection& conn);
+
+    Admission admit(Job const& job,
+                    Job::Clock::time_point until,
+                    std::unique_lock<std::mutex>& guard);
+    std::tuple<bool, Worker*> push(Job job, std::unique_lock<std::mutex>& guard);
+    bool isFull(Priority prio) const;
+    bool isCapped(std::string const& flow) const;
+    bool isDirect(Job const& job) const;
+    bool acquire(std::string const& flow);
+    void prune(Job::Clock::time_point now);
+    void enqueue(Job job);
+    void shed(bool is_whole);
+    bool pick(Job& job);
+    Job take(Lane& lane);
+    Job start(Job job);
+    void finish(std::string const& flow);
+    void hand(Slot& slot, Job job, std::unique_lock<std::mutex>& guard);
+    void sample();
+    void mark();
+    // Lets blocked senders know of the room in the queue.
+    void shrink();
+    size_t size() const;
 
     std::shared_ptr<Context const> ctx_;
-    std::queue<Job>                queue_;
+    Controller                     ctl_;
+    // Workers which have joined the pool and not left it yet.
+    int                            workers_ = 0;
+    // Workers allowed to join, still establishing their connections.
+    int                            starting_ = 0;
+    std::array<Lane, LANES>        lanes_;
+    std::map<std::string, Usage>   usages_;
+    size_t                         prune_at_ = MIN_PRUNE;
+    // Quit requests are served once all lanes are empty.
+    int                            quits_ = 0;
+    QueueStats                     stats_;
+    bool                           is_congested_ = false;
+    std::condition_variable        sig_room_;
     std::set<Slot*>                slots_;
     std::vector<Worker*>           recreation_;
     std::mutex                     mtx_;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <memory>
+#include <random>
+#include <postgres/internal/Job.h>
+
+namespace postgres {
+
+class Context;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Sizes the pool from the measured load instead of letting it follow every traffic wave.
+// The pool grows while jobs wait in the queue for too long, at most one connection
+// per scaling interval and a limited number of them at once,
+// and shrinks by one idle worker per idle timeout as long as less than a half of the workers are busy.
+// After a failure to connect the pool is not grown until a jittered exponential backoff is over.
+// Not thread-safe: the owner is supposed to guard it.
+class Controller {
+public:
+    using Clock = Job::Clock;
+
+    // Jittered delay doubled with every consecutive failure within the connect backoff bounds.
+    static Clock::duration backoff(Context const& ctx, int failures, std::minstd_rand& rnd);
+
+    explicit Controller(std::shared_ptr<Context const> ctx);
+    Controller(Controller const& other) = delete;
+    Controller& operator=(Controller const& other) = delete;
+    Controller(Controller&& other) noexcept = delete;
+    Controller& operator=(Controller&& other) noexcept = delete;
+    ~Controller() noexcept;
+
+    // Time spent by a job in the queue, jobs passed to idle workers directly wait for nothing.
+    void onWait(Clock::duration wait);
+    void onLoad(int busy, int size);
+
+    // Whether a worker should be added to the pool of the given size,
+    // including the workers still establishing their connections.
+    // A positive decision is remembered as a change of the pool size.
+    bool grow(int size, int starting, Clock::time_point now);
+    // Whether an idle worker should leave the pool of the given size.
+    bool shrink(int size, Clock::time_point now);
+    // Returns the delay before the next attempt to connect.
+    Clock::duration fail(Clock::time_point now);
+    void succeed();
+    // Failures to connect since the last success.
+    int failures() const;
+
+    // Smoothed measurements.
+    Clock::duration wait() const;
+    double load() const;
+
+private:
+    // Inverse weight of a new sample in the moving averages.
+    static constexpr auto SMOOTHING = 8;
+    // Share of busy workers below which the pool is allowed to shrink.
+    static constexpr auto LOW_LOAD = 0.5;
+
+    std::shared_ptr<Context const> ctx_;
+    Clock::duration                wait_{0};
+    double                         load_ = 0.0;
+    Clock::time_point              grown_;
+    Clock::time_point              changed_;
+    Clock::time_point              retry_;
+    int                            failures_ = 0;
+    std::minstd_rand               rnd_;
+};
+
+}  // namespace postgres::internal
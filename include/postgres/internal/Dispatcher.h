@@ -1,16 +1,24 @@
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
 #include <utility>
 #include <vector>
 #include <postgres/internal/IChannel.h>
+#include <postgres/internal/Job.h>
+#include <postgres/internal/Watchdog.h>
 
 namespace postgres {
 
 class Connection;
 class Context;
+class Result;
 
 }  // namespace postgres
 
@@ -18,6 +26,8 @@ namespace postgres::internal {
 
 class Worker;
 
+// Safe to use from multiple threads: the queue is guarded by the channel,
+// while workers are spawned into slots reserved with an atomic counter.
 class Dispatcher {
 public:
     explicit Dispatcher(std::shared_ptr<Context const> ctx, std::shared_ptr<IChannel> chan);
@@ -29,20 +39,145 @@ public:
 
     template <typename T>
     std::future<T> send(std::function<T(Connection&)> job) {
-        auto task = std::make_shared<std::packaged_task<T(Connection&)>>(std::move(job));
-        scale(chan_->send([task](Connection& conn) {
-            (*task)(conn);
-        }));
-        return task->get_future();
+        return send(std::move(job), Priority::NORMAL, Job::Clock::time_point::max(), {}, 0);
     }
 
+    // A job with a deadline is dropped if not started by it,
+    // otherwise its command is cancelled on the server once the deadline is passed.
+    // In both cases the future fails with TimeoutError.
+    // A job allowed retries is queued again after a backoff if its connection is lost.
+    template <typename T>
+    std::future<T> send(std::function<T(Connection&)> job,
+                        Priority prio,
+                        Job::Clock::time_point deadline,
+                        std::string flow,
+                        int retries) {
+        auto[task, res] = wrap(std::move(job), prio, deadline, std::move(flow), retries);
+        scale(chan_->send(std::move(task)));
+        return std::move(res);
+    }
+
+    // Waits for room in the queue until the time point.
+    // Returns nothing instead of throwing if the job is refused.
+    template <typename T>
+    std::optional<std::future<T>> trySend(std::function<T(Connection&)> job,
+                                          Priority prio,
+                                          Job::Clock::time_point deadline,
+                                          std::string flow,
+                                          int retries,
+                                          Job::Clock::time_point until) {
+        auto[task, res] = wrap(std::move(job), prio, deadline, std::move(flow), retries);
+        auto const params = chan_->trySend(std::move(task), until);
+        if (!params) {
+            return std::nullopt;
+        }
+        scale(*params);
+        return std::move(res);
+    }
+
+    QueueStats stats() const;
+
+    // Jobs sharing the same key are coalesced while the first one is in flight.
+    std::shared_future<Result> share(std::string key, std::function<Result(Connection&)> job);
+
 private:
+    struct Flights;
+
+    template <typename T>
+    std::pair<Job, std::future<T>> wrap(std::function<T(Connection&)> job,
+                                        Priority prio,
+                                        Job::Clock::time_point deadline,
+                                        std::string flow,
+                                        int retries) const {
+        auto const prom = std::make_shared<std::promise<T>>();
+        auto       res  = prom->get_future();
+        auto const fail = [prom](std::exception_ptr err) {
+            prom->set_exception(std::move(err));
+        };
+        if ((deadline == Job::Clock::time_point::max()) && (retries == 0)) {
+            return {Job{[prom, job = std::move(job)](Connection& conn) {
+                try {
+                    fulfil(*prom, job, conn);
+                } catch (...) {
+                    prom->set_exception(std::current_exception());
+                }
+            }, prio, deadline, std::move(flow), nullptr, fail}, std::move(res)};
+        }
+
+        auto const call = [job = std::move(job), deadline, dog = watchdog_](Connection& conn) -> T {
+            if (deadline == Job::Clock::time_point::max()) {
+                return job(conn);
+            }
+
+            auto const watch = dog->watch(conn, deadline);
+            try {
+                return job(conn);
+            } catch (...) {
+                if (watch.isFired()) {
+                    std::rethrow_exception(timeout("job is cancelled after deadline"));
+                }
+                throw;
+            }
+        };
+
+        auto const expire = [prom] {
+            prom->set_exception(timeout("job is expired in queue"));
+        };
+
+        // Each attempt queues the next one, referring to the function through the job.
+        auto const func = std::make_shared<Job::Func>();
+        *func = [prom, call, expire, fail, self = std::weak_ptr<Job::Func>{func},
+                 chan = std::weak_ptr<IChannel>{chan_}, ctx = ctx_,
+                 prio, deadline, flow, retries, attempt = 0](Connection& conn) mutable {
+            try {
+                fulfil(*prom, call, conn);
+                return;
+            } catch (...) {
+                auto const err = std::current_exception();
+                if ((attempt < retries) && isTransient(conn, err)) {
+                    std::this_thread::sleep_for(delay(*ctx, attempt++));
+                    auto const next = self.lock();
+                    auto const ch   = chan.lock();
+                    if (next && ch) {
+                        ch->retry(Job{[next](Connection& conn) {
+                            (*next)(conn);
+                        }, prio, deadline, flow, expire, fail});
+                        return;
+                    }
+                }
+                prom->set_exception(err);
+            }
+        };
+        return {Job{[func](Connection& conn) {
+            (*func)(conn);
+        }, prio, deadline, std::move(flow), expire, fail}, std::move(res)};
+    }
+
+    template <typename T, typename F>
+    static void fulfil(std::promise<T>& prom, F const& func, Connection& conn) {
+        if constexpr (std::is_void_v<T>) {
+            func(conn);
+            prom.set_value();
+        } else {
+            prom.set_value(func(conn));
+        }
+    }
+
+    static std::exception_ptr timeout(char const* msg);
+    // Whether the job has failed because of the connection rather than its own fault.
+    static bool isTransient(Connection& conn, std::exception_ptr const& err);
+    static Job::Clock::duration delay(Context const& ctx, int attempt);
+
     void scale(std::tuple<bool, Worker*> params);
     int size() const;
 
     std::shared_ptr<Context const>       ctx_;
     std::shared_ptr<IChannel>            chan_;
+    std::shared_ptr<Flights>             flights_;
+    std::shared_ptr<Watchdog>            watchdog_;
+    // Preallocated up to the maximum concurrency, so it is never reallocated.
     std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<int>                     spawned_ = 0;
 };
 
 }  // namespace postgres::internal
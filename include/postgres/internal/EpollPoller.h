@@ -0,0 +1,26 @@
+#pragma once
+
+#include <map>
+#include <postgres/internal/Poller.h>
+
+namespace postgres::internal {
+
+class EpollPoller : public Poller {
+public:
+    explicit EpollPoller();
+    EpollPoller(EpollPoller const& other) = delete;
+    EpollPoller& operator=(EpollPoller const& other) = delete;
+    EpollPoller(EpollPoller&& other) noexcept = delete;
+    EpollPoller& operator=(EpollPoller&& other) noexcept = delete;
+    ~EpollPoller() noexcept override;
+
+    EventBackend backend() const override;
+    void watch(int fd, short events) override;
+    void wait(std::vector<Event>& out) override;
+
+private:
+    int                  fd_ = -1;
+    std::map<int, short> watched_;
+};
+
+}  // namespace postgres::internal
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <exception>
+#include <optional>
 #include <tuple>
 #include <postgres/internal/Job.h>
+#include <postgres/QueueStats.h>
 
 namespace postgres::internal {
 
@@ -12,10 +15,21 @@ public:
     virtual ~IChannel() noexcept;
 
     virtual void quit(int count) = 0;
+    // Tells whether the job is taken care of without adding a worker,
+    // otherwise gives a worker to rerun if any.
     virtual std::tuple<bool, Worker*> send(Job job) = 0;
+    // Waits for room in the queue until the time point, returns nothing if the job is refused.
+    virtual std::optional<std::tuple<bool, Worker*>> trySend(Job job,
+                                                             Job::Clock::time_point until) = 0;
+    // Queues a job admitted before once more.
+    virtual void retry(Job job) = 0;
     virtual void receive(Slot& slot) = 0;
     virtual void recycle(Worker& worker) = 0;
+    // Reports the worker has failed to connect, leaving the pool if it has joined it.
+    // Returns the delay before the next attempt, or zero if the worker is recycled instead.
+    virtual Job::Clock::duration fail(Worker& worker, Slot& slot, std::exception_ptr const& err) = 0;
     virtual void drop() = 0;
+    virtual QueueStats stats() = 0;
 };
 
 }  // namespace postgres::internal
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <exception>
 #include <functional>
 #include <mutex>
+#include <string>
+#include <type_traits>
+#include <postgres/Priority.h>
 
 namespace postgres {
 
@@ -12,10 +18,66 @@ class Connection;
 
 namespace postgres::internal {
 
-using Job = std::function<void(Connection&)>;
+// Function executed by a worker, queued in the lane of its priority
+// among the jobs of its flow and optionally bound to a deadline.
+// Jobs expired before being started are not executed,
+// letting the submitter know through the expiration handler instead.
+// Likewise jobs which no connection can be established for are handed the error.
+class Job {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Func = std::function<void(Connection&)>;
+
+    Job();
+    Job(std::nullptr_t);
+
+    template <typename F,
+              typename = std::enable_if_t<!std::is_same_v<F, Job> &&
+                                          std::is_invocable_v<F&, Connection&>>>
+    Job(F func)
+        : func_{std::move(func)} {
+    }
+
+    explicit Job(Func func,
+                 Priority prio,
+                 Clock::time_point deadline,
+                 std::string flow,
+                 std::function<void()> expire,
+                 std::function<void(std::exception_ptr)> fail = nullptr);
+    Job(Job const& other);
+    Job& operator=(Job const& other);
+    Job(Job&& other) noexcept;
+    Job& operator=(Job&& other) noexcept;
+    ~Job() noexcept;
+
+    explicit operator bool() const;
+    void operator()(Connection& conn) const;
+    void swap(Job& other) noexcept;
+
+    bool isExpired(Clock::time_point now) const;
+    void expire() const;
+    void fail(std::exception_ptr const& err) const;
+    Priority priority() const;
+    Clock::time_point deadline() const;
+    std::string const& flow() const;
+
+private:
+    Func                                    func_;
+    Priority                                prio_     = Priority::NORMAL;
+    Clock::time_point                       deadline_ = Clock::time_point::max();
+    std::string                             flow_;
+    std::function<void()>                   expire_;
+    std::function<void(std::exception_ptr)> fail_;
+};
 
 struct Slot {
     Job                     job;
+    // Whether the worker is counted in the pool size.
+    bool                    is_joined = false;
+    // Whether the job is a health check, which does not end the idle time.
+    bool                    is_probed = false;
+    // When the worker has run out of jobs.
+    Job::Clock::time_point  idled;
     std::condition_variable signal;
     std::mutex              mtx;
 };
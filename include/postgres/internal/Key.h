@@ -0,0 +1,18 @@
+#pragma once
+
+#include <string>
+
+namespace postgres {
+
+class Command;
+class PreparedCommand;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Identifies a statement along with all of its arguments.
+std::string makeKey(Command const& cmd);
+std::string makeKey(PreparedCommand const& cmd);
+
+}  // namespace postgres::internal
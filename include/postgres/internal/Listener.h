@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace postgres {
+
+class Connection;
+struct Notification;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Owns a dedicated connection listening for notifications in a background thread.
+// The connection is recreated on loss and all the channels are listened again,
+// the reset callback is invoked then since some notifications might have been missed.
+class Listener {
+public:
+    using Factory = std::function<Connection()>;
+    using NotifyCallback = std::function<void(Notification)>;
+    using ResetCallback = std::function<void()>;
+
+    explicit Listener(Factory connect, NotifyCallback on_notify, ResetCallback on_reset);
+    Listener(Listener const& other) = delete;
+    Listener& operator=(Listener const& other) = delete;
+    Listener(Listener&& other) noexcept = delete;
+    Listener& operator=(Listener&& other) noexcept = delete;
+    ~Listener() noexcept;
+
+    void listen(std::string const& channel);
+    void unlisten(std::string const& channel);
+
+    // Tells whether LISTEN has been confirmed for the channel on the current connection.
+    bool isListening(std::string const& channel);
+
+private:
+    void run();
+    void serve(Connection& conn);
+    bool sync(Connection& conn);
+    void wake();
+    void pause(int failures);
+
+    Factory                  connect_;
+    NotifyCallback           on_notify_;
+    ResetCallback            on_reset_;
+    std::set<std::string>    channels_;
+    std::set<std::string>    listening_;
+    std::vector<std::string> pending_;
+    std::vector<std::string> dropped_;
+    bool                     is_stopped_ = false;
+    int                      pipe_[2]    = {-1, -1};
+    std::condition_variable  signal_;
+    std::mutex               mtx_;
+    std::thread              thread_;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <postgres/Replication.h>
+
+namespace postgres::internal {
+
+// Decodes messages of the pgoutput plugin, protocol version 1.
+// Relations are remembered to decode subsequent row changes.
+class LogicalDecoder {
+public:
+    explicit LogicalDecoder();
+    LogicalDecoder(LogicalDecoder const& other) = delete;
+    LogicalDecoder& operator=(LogicalDecoder const& other) = delete;
+    LogicalDecoder(LogicalDecoder&& other) noexcept;
+    LogicalDecoder& operator=(LogicalDecoder&& other) noexcept;
+    ~LogicalDecoder() noexcept;
+
+    // Messages of no interest, e.g. origins and types, yield nothing.
+    std::optional<Change> decode(std::string_view msg, Lsn lsn);
+
+private:
+    class Reader;
+
+    Tuple readTuple(Reader& in, std::shared_ptr<Relation const> const& rel);
+    std::shared_ptr<Relation const> const& relation(Oid id) const;
+
+    std::map<Oid, std::shared_ptr<Relation const>> relations_;
+    uint32_t                                       xid_ = 0;
+};
+
+}  // namespace postgres::internal
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <libpq-fe.h>
+#include <postgres/internal/Poller.h>
+#include <postgres/Connection.h>
+#include <postgres/EventBackend.h>
+#include <postgres/Result.h>
+
+namespace postgres::internal {
+
+// Runs statements of many threads on a few connections driven by a single background thread.
+// Each statement is sent to the connection with the fewest ones in flight,
+// pipelined if libpq supports it, and followed by a sync point, so a failing one affects no others.
+// Results of every connection are handed back in the order the statements were sent in.
+class Multiplexer {
+public:
+    using Factory = std::function<Connection()>;
+    // Sends a statement, returning 1 on success as libpq does.
+    using Send = std::function<int(PGconn*)>;
+
+    explicit Multiplexer(Factory const& connect, int connections, EventBackend backend);
+    Multiplexer(Multiplexer const& other) = delete;
+    Multiplexer& operator=(Multiplexer const& other) = delete;
+    Multiplexer(Multiplexer&& other) noexcept = delete;
+    Multiplexer& operator=(Multiplexer&& other) noexcept = delete;
+    ~Multiplexer() noexcept;
+
+    std::future<Result> submit(Send send);
+    bool isOk();
+    EventBackend backend() const;
+
+private:
+    struct Request {
+        Send                 send;
+        std::promise<Result> promise;
+    };
+
+    struct Pending {
+        std::promise<Result>                           promise;
+        std::unique_ptr<PGresult, void (*)(PGresult*)> res{nullptr, PQclear};
+    };
+
+    struct Link {
+        Connection          conn;
+        int                 fd;
+        std::deque<Pending> sent;
+        bool                is_lost   = false;
+        bool                is_synced = true;
+    };
+
+    void run();
+    void serve();
+    void dispatch();
+    bool sync(Link& link);
+    Link* pick();
+    bool receive(Link& link);
+    void complete(Pending& item);
+    void lose(Link& link);
+    void fail();
+    void wake();
+
+    // Accessed by the background thread only.
+    std::vector<Link>       links_;
+    std::map<int, Link*>    fds_;
+    int                     alive_ = 0;
+    std::unique_ptr<Poller> poller_;
+    std::deque<Request>     queue_;
+    bool                    is_stopped_ = false;
+    bool                    is_broken_  = false;
+    int                     pipe_[2]    = {-1, -1};
+    std::mutex              mtx_;
+    std::thread             thread_;
+};
+
+}  // namespace postgres::internal
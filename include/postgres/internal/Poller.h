@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <postgres/EventBackend.h>
+
+namespace postgres::internal {
+
+// Waits for many descriptors to become ready at once.
+// Readiness is level-triggered and reported with the poll() flags.
+class Poller {
+public:
+    struct Event {
+        int   fd;
+        short events;
+    };
+
+    static std::unique_ptr<Poller> create(EventBackend backend);
+
+    virtual ~Poller() noexcept;
+
+    virtual EventBackend backend() const = 0;
+    // Replaces the events of interest, no events stop watching the descriptor.
+    virtual void watch(int fd, short events) = 0;
+    // Blocks until at least one of the descriptors is ready.
+    virtual void wait(std::vector<Event>& out) = 0;
+};
+
+}  // namespace postgres::internal
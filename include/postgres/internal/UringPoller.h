@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <postgres/internal/Poller.h>
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace postgres::internal {
+
+// Drives io_uring through raw system calls, so no liburing is required.
+// Each descriptor has a one-shot poll armed, which is rearmed on the next wait
+// once it has fired, so all of the polls are submitted and reaped together.
+class UringPoller : public Poller {
+public:
+    // Throws if the kernel doesn't allow io_uring.
+    explicit UringPoller();
+    UringPoller(UringPoller const& other) = delete;
+    UringPoller& operator=(UringPoller const& other) = delete;
+    UringPoller(UringPoller&& other) noexcept = delete;
+    UringPoller& operator=(UringPoller&& other) noexcept = delete;
+    ~UringPoller() noexcept override;
+
+    EventBackend backend() const override;
+    void watch(int fd, short events) override;
+    void wait(std::vector<Event>& out) override;
+
+private:
+    struct Entry {
+        short    wanted = 0;
+        short    armed  = 0;
+        uint32_t gen    = 0;
+    };
+
+    void release();
+    void arm();
+    void push(uint8_t opcode, int fd, uint32_t events, uint64_t addr, uint64_t data);
+    void enter(unsigned min_complete);
+    void reap(std::vector<Event>& out);
+
+    int                  fd_ = -1;
+    void*                sq_ring_    = nullptr;
+    size_t               sq_size_    = 0;
+    void*                cq_ring_    = nullptr;
+    size_t               cq_size_    = 0;
+    io_uring_sqe*        sqes_       = nullptr;
+    size_t               sqes_size_  = 0;
+    unsigned*            sq_head_    = nullptr;
+    unsigned*            sq_tail_    = nullptr;
+    unsigned*            sq_array_   = nullptr;
+    unsigned             sq_mask_    = 0;
+    unsigned             sq_entries_ = 0;
+    unsigned*            cq_head_    = nullptr;
+    unsigned*            cq_tail_    = nullptr;
+    io_uring_cqe*        cqes_       = nullptr;
+    unsigned             cq_mask_    = 0;
+    std::map<int, Entry> entries_;
+    uint32_t             gen_ = 0;
+};
+
+}  // namespace postgres::internal
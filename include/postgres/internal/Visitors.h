@@ -6,6 +6,23 @@
 
 namespace postgres::internal {
 
+// Unsigned integers are mapped to serial columns, so their values are generated by the database.
+template <typename T>
+constexpr bool isGenerated() {
+    using U = std::remove_cv_t<T>;
+    return std::is_integral_v<U> && std::is_unsigned_v<U> && !std::is_same_v<U, bool>;
+}
+
+template <typename T>
+T& deref(T& val) {
+    return val;
+}
+
+template <typename T>
+T& deref(T* const val) {
+    return *val;
+}
+
 struct FieldsCollector {
     template <typename T>
     void accept(char const* const name) {
@@ -85,6 +102,24 @@ struct PlaceholdersCollector {
     std::string res;
 };
 
+struct ValuesCollector {
+    template <typename T>
+    void accept(char const*) {
+        if (!res.empty()) {
+            res += ",";
+        }
+        if (isGenerated<T>()) {
+            res += "DEFAULT";
+            return;
+        }
+        res += "$";
+        res += std::to_string(++idx);
+    }
+
+    int         idx = 0;
+    std::string res;
+};
+
 struct AssignmentsCollector {
     template <typename T>
     void accept(char const* const name) {
@@ -100,4 +135,11 @@ struct AssignmentsCollector {
     std::string res;
 };
 
+// Range of objects to insert leaving their generated fields to the database.
+template <typename Iter>
+struct InsertRange {
+    Iter beg;
+    Iter end;
+};
+
 }  // namespace postgres::internal
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <libpq-fe.h>
+
+namespace postgres {
+
+class Connection;
+
+}  // namespace postgres
+
+namespace postgres::internal {
+
+// Cancels commands still running on the server when their deadline is passed.
+// The thread is started with the first watch.
+class Watchdog {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    class Watch;
+
+    explicit Watchdog();
+    Watchdog(Watchdog const& other) = delete;
+    Watchdog& operator=(Watchdog const& other) = delete;
+    Watchdog(Watchdog&& other) noexcept = delete;
+    Watchdog& operator=(Watchdog&& other) noexcept = delete;
+    ~Watchdog() noexcept;
+
+    Watch watch(Connection const& conn, Clock::time_point deadline);
+
+private:
+    struct Entry;
+
+    using Entries = std::multimap<Clock::time_point, std::shared_ptr<Entry>>;
+
+    void run();
+    void release(Watch const& watch);
+
+    Entries                 entries_;
+    bool                    is_stopped_ = false;
+    std::condition_variable signal_;
+    std::condition_variable fired_;
+    std::mutex              mtx_;
+    std::thread             thread_;
+};
+
+// Keeps the connection watched until destroyed.
+class Watchdog::Watch {
+public:
+    Watch(Watch const& other) = delete;
+    Watch& operator=(Watch const& other) = delete;
+    Watch(Watch&& other) noexcept = delete;
+    Watch& operator=(Watch&& other) noexcept = delete;
+    ~Watch() noexcept;
+
+    // Whether the cancellation has been requested.
+    bool isFired() const;
+
+private:
+    friend class Watchdog;
+
+    explicit Watch(Watchdog& dog, Entries::iterator it);
+
+    Watchdog&              dog_;
+    Entries::iterator      it_;
+    std::shared_ptr<Entry> entry_;
+};
+
+}  // namespace postgres::internal
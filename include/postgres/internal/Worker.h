@@ -1,11 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <thread>
 #include <postgres/internal/Job.h>
 
 namespace postgres {
 
+class Connection;
 class Context;
 
 }  // namespace postgres
@@ -26,6 +28,9 @@ public:
     void run();
 
 private:
+    std::optional<Connection> connect();
+    bool isWornOut(Job::Clock::time_point born) const;
+
     std::shared_ptr<Context const> ctx_;
     std::shared_ptr<IChannel>      chan_;
     Slot                           slot_;
@@ -0,0 +1,21 @@
+#include <postgres/internal/Backoff.h>
+
+#include <algorithm>
+
+namespace postgres::internal {
+
+std::chrono::nanoseconds backoff(std::chrono::nanoseconds const min,
+                                 std::chrono::nanoseconds const max,
+                                 int const                      failures,
+                                 std::minstd_rand&              rnd) {
+    auto delay = min;
+    for (auto i = 1; (i < failures) && (delay < max); ++i) {
+        delay *= 2;
+    }
+    delay = std::min(delay, max);
+
+    std::uniform_int_distribution<std::chrono::nanoseconds::rep> dist{(delay.count() + 1) / 2, delay.count()};
+    return std::chrono::nanoseconds{dist(rnd)};
+}
+
+}  // namespace postgres::internal
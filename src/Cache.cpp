@@ -0,0 +1,158 @@
+#include <postgres/Cache.h>
+
+#include <utility>
+#include <postgres/internal/Listener.h>
+#include <postgres/Config.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Notification.h>
+
+namespace postgres {
+
+Cache::Cache()
+    : ttl_{std::chrono::minutes{1}}, max_size_{1024} {
+}
+
+Cache::~Cache() noexcept = default;
+
+Cache::Value Cache::get(std::string const& key) {
+    std::lock_guard guard{mtx_};
+    auto const      it = index_.find(key);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+
+    auto const entry = it->second;
+    if (entry->expiry <= Clock::now()) {
+        erase(entry);
+        return nullptr;
+    }
+
+    entries_.splice(entries_.begin(), entries_, entry);
+    return entry->value;
+}
+
+void Cache::put(std::string const& key, std::string const& channel, Value val) {
+    // Nothing is cached for a channel until it is listened, so no invalidation is missed.
+    if (listener_) {
+        listener_->listen(channel);
+        if (!listener_->isListening(channel)) {
+            return;
+        }
+    }
+
+    std::lock_guard guard{mtx_};
+    auto const      it = index_.find(key);
+    if (it != index_.end()) {
+        erase(it->second);
+    }
+
+    entries_.push_front(Entry{key, channel, Clock::now() + ttl_, std::move(val)});
+    index_.emplace(key, entries_.begin());
+    while (max_size_ < static_cast<int>(entries_.size())) {
+        erase(std::prev(entries_.end()));
+    }
+}
+
+void Cache::erase(std::string const& key) {
+    std::lock_guard guard{mtx_};
+    auto const      it = index_.find(key);
+    if (it != index_.end()) {
+        erase(it->second);
+    }
+}
+
+void Cache::erase(std::string const& key, Value const& val) {
+    std::lock_guard guard{mtx_};
+    auto const      it = index_.find(key);
+    if ((it != index_.end()) && (it->second->value == val)) {
+        erase(it->second);
+    }
+}
+
+void Cache::invalidate(std::string const& channel) {
+    std::lock_guard guard{mtx_};
+    for (auto it = entries_.begin(); it != entries_.end();) {
+        auto const entry = it++;
+        if (entry->channel == channel) {
+            erase(entry);
+        }
+    }
+}
+
+void Cache::clear() {
+    std::lock_guard guard{mtx_};
+    index_.clear();
+    entries_.clear();
+}
+
+int Cache::size() {
+    std::lock_guard guard{mtx_};
+    return static_cast<int>(entries_.size());
+}
+
+Cache::Duration Cache::timeToLive() const {
+    return ttl_;
+}
+
+int Cache::maxSize() const {
+    return max_size_;
+}
+
+void Cache::erase(Entries::iterator const it) {
+    index_.erase(it->key);
+    entries_.erase(it);
+}
+
+Cache::Builder::Builder()
+    : cache_{new Cache{}} {
+}
+
+Cache::Builder::Builder(Builder&& other) noexcept = default;
+
+Cache::Builder& Cache::Builder::operator=(Builder&& other) noexcept = default;
+
+Cache::Builder::~Builder() noexcept = default;
+
+Cache::Builder& Cache::Builder::timeToLive(Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < val.count(), "bad time to live: " << val.count());
+    cache_->ttl_ = val;
+    return *this;
+}
+
+Cache::Builder& Cache::Builder::maxSize(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad cache size: " << val);
+    cache_->max_size_ = val;
+    return *this;
+}
+
+Cache::Builder& Cache::Builder::listen(Config cfg) {
+    connect_ = [cfg = std::make_shared<Config const>(std::move(cfg))] {
+        return Connection{*cfg};
+    };
+    return *this;
+}
+
+Cache::Builder& Cache::Builder::listen(std::string uri) {
+    connect_ = [uri = std::move(uri)] {
+        return Connection{uri};
+    };
+    return *this;
+}
+
+std::shared_ptr<Cache> Cache::Builder::share() {
+    if (connect_) {
+        auto const raw = cache_.get();
+        raw->listener_ = std::make_unique<internal::Listener>(
+            std::move(connect_),
+            [raw](Notification note) {
+                raw->invalidate(note.channel);
+            },
+            [raw] {
+                raw->clear();
+            });
+    }
+    return std::move(cache_);
+}
+
+}  // namespace postgres
@@ -1,48 +1,112 @@
 #include <postgres/internal/Channel.h>
 
+#include <algorithm>
+#include <chrono>
 #include <utility>
+#include <postgres/Connection.h>
 #include <postgres/Context.h>
 #include <postgres/Error.h>
 
 namespace postgres::internal {
 
 Channel::Channel(std::shared_ptr<Context const> ctx)
-    : ctx_{std::move(ctx)} {
+    : ctx_{std::move(ctx)}, ctl_{ctx_} {
 }
 
 Channel::~Channel() noexcept = default;
 
 void Channel::quit(int count) {
     while (0 < count--) {
-        send(nullptr, 0);
+        std::unique_lock guard{mtx_};
+        push(nullptr, guard);
     }
 }
 
 std::tuple<bool, Worker*> Channel::send(Job job) {
-    return send(std::move(job), ctx_->maxQueueSize());
+    std::unique_lock guard{mtx_};
+    switch (admit(job, Job::Clock::now(), guard)) {
+        case Admission::ACCEPTED: {
+            break;
+        }
+        case Admission::FULL: {
+            _POSTGRES_CXX_FAIL(RuntimeError, "queue overflow");
+        }
+        case Admission::LIMITED: {
+            _POSTGRES_CXX_FAIL(RuntimeError, "rate limit exceeded for flow '" << job.flow() << "'");
+        }
+    }
+    return push(std::move(job), guard);
 }
 
-std::tuple<bool, Worker*> Channel::send(Job job, int const lim) {
-    std::unique_lock c_guard{mtx_};
-    if (!slots_.empty()) {
+std::optional<std::tuple<bool, Worker*>> Channel::trySend(Job job,
+                                                          Job::Clock::time_point const until) {
+    std::unique_lock guard{mtx_};
+    if (admit(job, until, guard) != Admission::ACCEPTED) {
+        return std::nullopt;
+    }
+    return push(std::move(job), guard);
+}
+
+Channel::Admission Channel::admit(Job const&                    job,
+                                  Job::Clock::time_point const  until,
+                                  std::unique_lock<std::mutex>& guard) {
+    auto const is_room = [this, &job] {
+        return isDirect(job) || !isFull(job.priority());
+    };
+    if (!is_room()) {
+        // Make room at the expense of jobs nobody waits for anymore.
+        shed(true);
+        auto is_admitted = true;
+        if (until == Job::Clock::time_point::max()) {
+            sig_room_.wait(guard, is_room);
+        } else {
+            is_admitted = sig_room_.wait_until(guard, until, is_room);
+        }
+        if (!is_admitted) {
+            ++stats_.rejected;
+            return Admission::FULL;
+        }
+    }
+
+    if (!job) {
+        return Admission::ACCEPTED;
+    }
+    if (!acquire(job.flow())) {
+        ++stats_.rejected;
+        return Admission::LIMITED;
+    }
+    ++stats_.accepted;
+    return Admission::ACCEPTED;
+}
+
+std::tuple<bool, Worker*> Channel::push(Job job, std::unique_lock<std::mutex>& guard) {
+    if (isDirect(job)) {
         auto const it   = slots_.begin();
         auto const slot = *it;
         slots_.erase(it);
-        c_guard.unlock();
-
-        std::lock_guard s_guard{slot->mtx};
-        slot->job.swap(job);
-        slot->signal.notify_one();
+        if (job) {
+            ctl_.onWait(Job::Clock::duration::zero());
+        }
+        sample();
+        hand(*slot, job ? start(std::move(job)) : std::move(job), guard);
         return {true, nullptr};
     }
 
-    if (0 < lim) {
-        _POSTGRES_CXX_ASSERT(RuntimeError,
-                             (static_cast<int>(queue_.size()) < lim),
-                             "queue overflow");
+    auto const is_job = static_cast<bool>(job);
+    if (is_job) {
+        enqueue(std::move(job));
+    } else {
+        ++quits_;
     }
+    sample();
 
-    queue_.push(std::move(job));
+    // Workers kept idle by flow limits are of no help, neither would be a new one.
+    if (is_job) {
+        if (!slots_.empty() || !ctl_.grow(workers_, starting_, Job::Clock::now())) {
+            return {true, nullptr};
+        }
+        ++starting_;
+    }
     if (recreation_.empty()) {
         return {false, nullptr};
     }
@@ -52,48 +116,438 @@ std::tuple<bool, Worker*> Channel::send(Job job, int const lim) {
     return {false, worker};
 }
 
+// Neither limits nor statistics apply to the jobs admitted already,
+// nor is the pool grown since the worker of the failed attempt is still there.
+void Channel::retry(Job job) {
+    std::unique_lock guard{mtx_};
+    if (isDirect(job)) {
+        auto const it   = slots_.begin();
+        auto const slot = *it;
+        slots_.erase(it);
+        hand(*slot, start(std::move(job)), guard);
+        return;
+    }
+    enqueue(std::move(job));
+}
+
 void Channel::receive(Slot& slot) {
     std::unique_lock c_guard{mtx_};
-    if (!queue_.empty()) {
-        queue_.front().swap(slot.job);
-        queue_.pop();
+    if (!slot.is_probed) {
+        slot.idled = Job::Clock::now();
+    }
+    slot.is_probed = false;
+    if (!slot.is_joined) {
+        slot.is_joined = true;
+        ++workers_;
+        // Workers started bypassing the controller are not counted as starting.
+        starting_ = std::max(0, starting_ - 1);
+        ctl_.succeed();
+    }
+    shed(false);
+    if (pick(slot.job)) {
+        sample();
+        return;
+    }
+    if ((size() == 0) && (0 < quits_)) {
+        --quits_;
+        slot.job = nullptr;
         return;
     }
 
     // Keep slots sorted to detect idle workers.
     slots_.insert(&slot);
+    sample();
+    // Jobs can be passed to the slot directly now.
+    sig_room_.notify_all();
     // Prevent filling the slot until waiting.
     std::unique_lock s_guard{slot.mtx};
     c_guard.unlock();
 
     auto const timeout = ctx_->idleTimeout();
-    if (timeout.count() == 0) {
+    auto const check   = ctx_->validationInterval();
+    if ((timeout.count() == 0) && (check.count() == 0)) {
         slot.signal.wait(s_guard);
         return;
     }
 
-    if (slot.signal.wait_for(s_guard, timeout) == std::cv_status::no_timeout) {
-        return;
-    }
+    auto const never  = Job::Clock::time_point::max();
+    auto       retire = (0 < timeout.count()) ? slot.idled + timeout : never;
+    auto const probe  = (0 < check.count()) ? Job::Clock::now() + check : never;
+    while (slot.signal.wait_until(s_guard, std::min(retire, probe)) == std::cv_status::timeout) {
+        // Check if other thread is going to fill the slot.
+        c_guard.lock();
+        if (slots_.count(&slot) == 0) {
+            c_guard.unlock();
+            slot.signal.wait(s_guard);
+            return;
+        }
 
-    // Check if other thread is going to fill the slot.
-    c_guard.lock();
-    if (0 < slots_.erase(&slot)) {
-        return;
-    }
+        // Idle workers leave the pool one at a time, as the controller decides.
+        auto const now = Job::Clock::now();
+        if (retire <= now) {
+            if (ctl_.shrink(workers_, now)) {
+                slots_.erase(&slot);
+                return;
+            }
+            retire = now + timeout;
+        }
 
-    c_guard.unlock();
-    slot.signal.wait(s_guard);
+        // The rest check their connections, so that broken ones are restored before a job comes.
+        if (probe <= now) {
+            slots_.erase(&slot);
+            slot.job       = validate;
+            slot.is_probed = true;
+            return;
+        }
+        c_guard.unlock();
+    }
 }
 
 void Channel::recycle(Worker& worker) {
     std::lock_guard guard{mtx_};
+    --workers_;
     recreation_.push_back(&worker);
 }
 
+// Keeps trying while there are jobs to serve, unless shutting down.
+// Once the attempts in a row are exhausted with no connection left in the pool,
+// the jobs waiting for one fail with the error instead.
+Job::Clock::duration Channel::fail(Worker& worker, Slot& slot, std::exception_ptr const& err) {
+    std::unique_lock guard{mtx_};
+    // A worker failing to restore its connection is starting anew.
+    if (slot.is_joined) {
+        slot.is_joined = false;
+        --workers_;
+        ++starting_;
+    }
+
+    auto const delay = ctl_.fail(Job::Clock::now());
+    auto const lim   = ctx_->maxConnectAttempts();
+    if ((workers_ == 0) && (0 < lim) && (lim <= ctl_.failures()) && (size() != 0)) {
+        auto const garbage = std::move(lanes_);
+        lanes_ = {};
+        shrink();
+        guard.unlock();
+        for (auto const& lane : garbage) {
+            for (auto const& [id, flow] : lane.flows) {
+                for (auto const& [key, entry] : flow.queue) {
+                    entry.job.fail(err);
+                }
+            }
+        }
+        guard.lock();
+    }
+    if ((size() != 0) && (quits_ == 0)) {
+        return delay;
+    }
+
+    starting_ = std::max(0, starting_ - 1);
+    recreation_.push_back(&worker);
+    return Job::Clock::duration::zero();
+}
+
 void Channel::drop() {
     std::lock_guard guard{mtx_};
-    auto const      garbage = std::move(queue_);
+    auto const      garbage = std::move(lanes_);
+    lanes_ = {};
+    quits_ = 0;
+    shrink();
+}
+
+QueueStats Channel::stats() {
+    std::lock_guard guard{mtx_};
+    auto            res = stats_;
+    res.size         = size();
+    res.is_congested = is_congested_;
+    return res;
+}
+
+// Empty query makes a round trip to the server, updating the connection status.
+// Its result is not turned into Status, which throws on anything but success,
+// since the probe runs outside of any caller able to handle errors.
+void Channel::validate(Connection& conn) {
+    PQclear(PQexec(conn.native(), ""));
+}
+
+// Lanes with a limit of their own are not restricted by the overall one.
+bool Channel::isFull(Priority const prio) const {
+    auto const lane_lim = ctx_->maxQueueSize(prio);
+    if (0 < lane_lim) {
+        return lane_lim <= static_cast<int>(lanes_[static_cast<size_t>(prio)].size);
+    }
+
+    auto const lim = ctx_->maxQueueSize();
+    return (0 < lim) && (lim <= static_cast<int>(size()) + quits_);
+}
+
+bool Channel::isCapped(std::string const& flow) const {
+    auto const lim = ctx_->flow(flow).max_concurrency;
+    if (lim == 0) {
+        return false;
+    }
+
+    auto const it = usages_.find(flow);
+    return (it != usages_.end()) && (lim <= it->second.running);
+}
+
+// Quit requests must not overtake waiting jobs.
+bool Channel::isDirect(Job const& job) const {
+    return !slots_.empty() && (job ? !isCapped(job.flow()) : (size() == 0));
+}
+
+// Takes a token from the bucket of the flow if its rate is limited.
+bool Channel::acquire(std::string const& flow) {
+    auto const& cfg = ctx_->flow(flow);
+    if (cfg.rate == 0.0) {
+        return true;
+    }
+
+    auto const now = Job::Clock::now();
+    prune(now);
+
+    auto const[it, is_new] = usages_.try_emplace(flow);
+    auto&      usage       = it->second;
+    if (is_new) {
+        usage.tokens = cfg.burst;
+    } else {
+        std::chrono::duration<double> const elapsed = now - usage.refilled;
+        usage.tokens = std::min<double>(cfg.burst, usage.tokens + cfg.rate * elapsed.count());
+    }
+    usage.refilled = now;
+
+    if (usage.tokens < 1.0) {
+        return false;
+    }
+    usage.tokens -= 1.0;
+    return true;
+}
+
+// Forgets the flows at rest, with no jobs running and their buckets full again,
+// whenever the number of the remembered ones has doubled since the last time.
+// A forgotten flow starts with a full bucket, so nothing changes for it.
+void Channel::prune(Job::Clock::time_point const now) {
+    if (usages_.size() < prune_at_) {
+        return;
+    }
+
+    for (auto it = usages_.begin(); it != usages_.end();) {
+        auto const&                         cfg     = ctx_->flow(it->first);
+        auto const&                         usage   = it->second;
+        std::chrono::duration<double> const elapsed = now - usage.refilled;
+        if ((usage.running == 0) && (cfg.burst <= usage.tokens + cfg.rate * elapsed.count())) {
+            it = usages_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    prune_at_ = std::max(MIN_PRUNE, usages_.size() * 2);
+}
+
+void Channel::enqueue(Job job) {
+    auto&      lane = lanes_[static_cast<size_t>(job.priority())];
+    auto const key  = (ctx_->queuePolicy() == QueuePolicy::EARLIEST_DEADLINE)
+                      ? job.deadline()
+                      : Job::Clock::time_point::max();
+
+    auto const[it, is_new] = lane.flows.try_emplace(job.flow());
+    if (is_new) {
+        lane.turns.push_back(job.flow());
+    }
+    it->second.queue.emplace(key, Entry{std::move(job), Job::Clock::now()});
+    ++lane.size;
+    mark();
+}
+
+void Channel::shed(bool const is_whole) {
+    auto const now    = Job::Clock::now();
+    auto const before = size();
+    for (auto& lane : lanes_) {
+        for (auto flow = lane.flows.begin(); flow != lane.flows.end();) {
+            auto& queue = flow->second.queue;
+            for (auto it = queue.begin(); it != queue.end();) {
+                if (!it->second.job.isExpired(now)) {
+                    if (!is_whole) {
+                        break;
+                    }
+                    ++it;
+                    continue;
+                }
+
+                it->second.job.expire();
+                it = queue.erase(it);
+                --lane.size;
+                ++stats_.expired;
+            }
+
+            if (!queue.empty()) {
+                ++flow;
+                continue;
+            }
+            lane.turns.erase(std::find(lane.turns.begin(), lane.turns.end(), flow->first));
+            flow = lane.flows.erase(flow);
+        }
+    }
+    if (size() < before) {
+        shrink();
+    }
+}
+
+// Jobs are promoted by one lane for every aging interval spent in the queue,
+// so that lower priorities are not starved.
+bool Channel::pick(Job& job) {
+    auto const now   = Job::Clock::now();
+    auto const aging = ctx_->agingInterval();
+    Lane*      res   = nullptr;
+    int64_t    best  = 0;
+    for (size_t i = 0; i < LANES; ++i) {
+        auto& lane   = lanes_[i];
+        auto  oldest = Job::Clock::time_point::max();
+        for (auto const& [id, flow] : lane.flows) {
+            if (!isCapped(id)) {
+                oldest = std::min(oldest, flow.queue.begin()->second.queued);
+            }
+        }
+        if (oldest == Job::Clock::time_point::max()) {
+            continue;
+        }
+
+        auto rank = static_cast<int64_t>(i);
+        if (0 < aging.count()) {
+            rank -= static_cast<int64_t>((now - oldest) / aging);
+        }
+        if ((res == nullptr) || (rank < best)) {
+            res  = &lane;
+            best = rank;
+        }
+    }
+
+    if (res == nullptr) {
+        return false;
+    }
+    job = take(*res);
+    return true;
+}
+
+// Each turn a flow is credited with its weight and served until the credit is spent.
+Job Channel::take(Lane& lane) {
+    while (true) {
+        auto const id = std::move(lane.turns.front());
+        lane.turns.pop_front();
+        if (isCapped(id)) {
+            lane.turns.push_back(id);
+            continue;
+        }
+
+        auto const it   = lane.flows.find(id);
+        auto&      flow = it->second;
+        if (flow.deficit < 1) {
+            flow.deficit += ctx_->flow(id).weight;
+        }
+
+        auto const head = flow.queue.begin();
+        auto       job  = std::move(head->second.job);
+        ctl_.onWait(Job::Clock::now() - head->second.queued);
+        flow.queue.erase(head);
+        --flow.deficit;
+        --lane.size;
+
+        if (flow.queue.empty()) {
+            lane.flows.erase(it);
+        } else if (0 < flow.deficit) {
+            lane.turns.push_front(id);
+        } else {
+            lane.turns.push_back(id);
+        }
+        shrink();
+        return start(std::move(job));
+    }
+}
+
+// Keeps the flow busy until the job is destroyed, either executed or expired.
+Job Channel::start(Job job) {
+    auto flow = job.flow();
+    if (ctx_->flow(flow).max_concurrency == 0) {
+        return job;
+    }
+
+    ++usages_[flow].running;
+    std::shared_ptr<void> const guard{nullptr, [this, flow](void*) {
+        finish(flow);
+    }};
+
+    auto const prio     = job.priority();
+    auto const deadline = job.deadline();
+    auto const inner    = std::make_shared<Job>(std::move(job));
+    return Job{[inner, guard](Connection& conn) {
+        (*inner)(conn);
+    }, prio, deadline, std::move(flow), [inner, guard] {
+        inner->expire();
+    }, [inner, guard](std::exception_ptr err) {
+        inner->fail(err);
+    }};
+}
+
+void Channel::finish(std::string const& flow) {
+    std::unique_lock guard{mtx_};
+    auto const       it = usages_.find(flow);
+    if ((--it->second.running == 0) && (ctx_->flow(flow).rate == 0.0)) {
+        usages_.erase(it);
+    }
+
+    // Jobs of the flow might be waiting for idle workers, so might quit requests.
+    while (!slots_.empty()) {
+        Job job{};
+        if (!pick(job)) {
+            if ((size() != 0) || (quits_ == 0)) {
+                return;
+            }
+            --quits_;
+        }
+
+        auto const slot = *slots_.begin();
+        slots_.erase(slots_.begin());
+        hand(*slot, std::move(job), guard);
+        guard.lock();
+    }
+}
+
+void Channel::hand(Slot& slot, Job job, std::unique_lock<std::mutex>& guard) {
+    guard.unlock();
+    std::lock_guard s_guard{slot.mtx};
+    slot.job.swap(job);
+    slot.signal.notify_one();
+}
+
+void Channel::sample() {
+    ctl_.onLoad(workers_ - static_cast<int>(slots_.size()), workers_);
+}
+
+// Crossing the high watermark marks the queue congested until it drains to the low one.
+void Channel::mark() {
+    auto const high = ctx_->highWatermark();
+    if (high == 0) {
+        return;
+    }
+
+    auto const len = static_cast<int>(size());
+    if (high <= len) {
+        is_congested_ = true;
+    } else if (len <= ctx_->lowWatermark()) {
+        is_congested_ = false;
+    }
+}
+
+void Channel::shrink() {
+    mark();
+    sig_room_.notify_all();
+}
+
+size_t Channel::size() const {
+    size_t res = 0;
+    for (auto const& lane : lanes_) {
+        res += lane.size;
+    }
+    return res;
 }
 
 }  // namespace postgres::internal
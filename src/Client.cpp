@@ -1,11 +1,16 @@
 #include <postgres/Client.h>
 
+#include <future>
 #include <utility>
+#include <postgres/internal/BoundedQueue.h>
 #include <postgres/internal/Channel.h>
 #include <postgres/internal/Dispatcher.h>
 #include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/PreparedCommand.h>
 #include <postgres/Result.h>
 #include <postgres/Status.h>
+#include <postgres/Stream.h>
 
 namespace postgres {
 
@@ -16,7 +21,8 @@ Client::Client()
 Client::Client(Context ctx) {
     auto pctx = std::make_shared<Context>(std::move(ctx));
     auto chan = std::make_shared<internal::Channel>(pctx);
-    impl_ = std::make_unique<Impl>(std::move(pctx), std::move(chan));
+    cache_ = pctx->cache();
+    impl_  = std::make_unique<Impl>(std::move(pctx), std::move(chan));
 }
 
 Client::Client(Client&& other) noexcept = default;
@@ -33,4 +39,163 @@ std::future<Result> Client::query(std::function<Result(Connection&)> job) {
     return impl_->send(std::move(job));
 }
 
+std::future<Status> Client::exec(std::function<Status(Connection&)> job, Duration const timeout) {
+    return exec(std::move(job), JobOptions{}.timeout(timeout));
+}
+
+std::future<Result> Client::query(std::function<Result(Connection&)> job, Duration const timeout) {
+    return query(std::move(job), JobOptions{}.timeout(timeout));
+}
+
+std::future<Status> Client::exec(std::function<Status(Connection&)> job, Priority const prio) {
+    return exec(std::move(job), JobOptions{}.priority(prio));
+}
+
+std::future<Result> Client::query(std::function<Result(Connection&)> job, Priority const prio) {
+    return query(std::move(job), JobOptions{}.priority(prio));
+}
+
+std::future<Status> Client::exec(std::function<Status(Connection&)> job,
+                                 Priority const prio,
+                                 Duration const timeout) {
+    return exec(std::move(job), JobOptions{}.priority(prio).timeout(timeout));
+}
+
+std::future<Result> Client::query(std::function<Result(Connection&)> job,
+                                  Priority const prio,
+                                  Duration const timeout) {
+    return query(std::move(job), JobOptions{}.priority(prio).timeout(timeout));
+}
+
+std::future<Status> Client::exec(std::function<Status(Connection&)> job, JobOptions const& opts) {
+    return submit(std::move(job), opts);
+}
+
+std::future<Result> Client::query(std::function<Result(Connection&)> job, JobOptions const& opts) {
+    return submit(std::move(job), opts);
+}
+
+std::optional<std::future<Status>> Client::tryExec(std::function<Status(Connection&)> job,
+                                                   JobOptions const& opts) {
+    return trySubmit(std::move(job), opts);
+}
+
+std::optional<std::future<Result>> Client::tryQuery(std::function<Result(Connection&)> job,
+                                                    JobOptions const& opts) {
+    return trySubmit(std::move(job), opts);
+}
+
+template <typename T>
+std::future<T> Client::submit(std::function<T(Connection&)> job, JobOptions const& opts) {
+    if (!opts.block()) {
+        return impl_->send(std::move(job),
+                           opts.priority(),
+                           deadline(opts),
+                           opts.flow(),
+                           opts.retries());
+    }
+
+    auto res = trySubmit(std::move(job), opts);
+    _POSTGRES_CXX_ASSERT(RuntimeError, res, "job is not admitted in time");
+    return std::move(*res);
+}
+
+template <typename T>
+std::optional<std::future<T>> Client::trySubmit(std::function<T(Connection&)> job,
+                                                JobOptions const& opts) {
+    return impl_->trySend(std::move(job),
+                          opts.priority(),
+                          deadline(opts),
+                          opts.flow(),
+                          opts.retries(),
+                          until(opts));
+}
+
+std::chrono::steady_clock::time_point Client::deadline(JobOptions const& opts) {
+    auto const& timeout = opts.timeout();
+    return timeout ? std::chrono::steady_clock::now() + *timeout
+                   : std::chrono::steady_clock::time_point::max();
+}
+
+std::chrono::steady_clock::time_point Client::until(JobOptions const& opts) {
+    auto const& block = opts.block();
+    if (!block) {
+        return std::chrono::steady_clock::now();
+    }
+    if (*block == JobOptions::Duration::max()) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+    return std::chrono::steady_clock::now() + *block;
+}
+
+void Client::post(std::function<void(Connection&)> job) {
+    impl_->send(std::move(job));
+}
+
+Stream Client::stream(Command cmd, int const chunk_size, int const max_chunks) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < chunk_size, "bad chunk size: " << chunk_size);
+
+    using Queue = internal::BoundedQueue<Result>;
+    auto const queue = std::make_shared<Queue>(max_chunks);
+
+    // Let the caller know if the job is dropped without being executed.
+    std::shared_ptr<void> const guard{nullptr, [queue](void*) {
+        queue->fail(std::make_exception_ptr(std::future_error{std::future_errc::broken_promise}));
+    }};
+
+    post([queue, guard, cmd = std::make_shared<Command>(std::move(cmd)), chunk_size](Connection& conn) {
+        try {
+            auto stream = conn.stream(*cmd, chunk_size);
+            while (true) {
+                auto       res     = stream.take();
+                auto const is_over = res.isEmpty();
+                if (!queue->push(std::move(res)) || is_over) {
+                    break;
+                }
+            }
+            queue->close();
+        } catch (...) {
+            queue->fail(std::current_exception());
+        }
+    });
+
+    return Stream{[queue] {
+        auto res = queue->pop();
+        _POSTGRES_CXX_ASSERT(LogicError, res, "rows stream is over");
+        return std::move(*res);
+    }, [queue] {
+        queue->close();
+    }};
+}
+
+QueueStats Client::stats() const {
+    return impl_->stats();
+}
+
+std::future<Result> Client::retryTransaction(std::function<Result(Connection&)> job,
+                                             RetryPolicy policy,
+                                             JobOptions const& opts) {
+    return query(
+        [job = std::move(job), policy = std::move(policy)](Connection& conn) {
+            return conn.retryTransaction(job, policy);
+        },
+        opts);
+}
+
+std::shared_future<Result> Client::queryShared(Command cmd) {
+    auto key = internal::makeKey(cmd);
+    return impl_->share(std::move(key),
+                        [cmd = std::make_shared<Command>(std::move(cmd))](Connection& conn) {
+                            return conn.exec(*cmd);
+                        });
+}
+
+std::shared_future<Result> Client::queryShared(PreparedCommand cmd) {
+    auto key = internal::makeKey(cmd);
+    return impl_->share(std::move(key),
+                        [cmd = std::make_shared<PreparedCommand>(std::move(cmd))](Connection& conn) {
+                            return conn.exec(*cmd);
+                        });
+}
+
 }  // namespace postgres
@@ -3,9 +3,22 @@
 
 namespace postgres {
 
-Command::Command(Command&& other) noexcept = default;
+Command::Command(Command&& other) noexcept {
+    *this = std::move(other);
+}
 
-Command& Command::operator=(Command&& other) noexcept = default;
+// Own statement may be stored in a small string buffer which doesn't survive a move.
+Command& Command::operator=(Command&& other) noexcept {
+    auto const is_own = (other.stmt_ == other.stmt_buf_.data());
+    stmt_buf_ = std::move(other.stmt_buf_);
+    stmt_     = is_own ? stmt_buf_.data() : other.stmt_;
+    types_    = std::move(other.types_);
+    values_   = std::move(other.values_);
+    lengths_  = std::move(other.lengths_);
+    formats_  = std::move(other.formats_);
+    buf_      = std::move(other.buf_);
+    return *this;
+}
 
 Command::~Command() noexcept = default;
 
@@ -66,11 +79,74 @@ void Command::add(char const* const s) {
     values_.push_back(s);
 }
 
+void Command::add(std::vector<std::string> const& arr) {
+    auto data = makeArray(TEXTOID, arr.size());
+    for (auto const& s : arr) {
+        appendArrayItem(data, s.data(), static_cast<int32_t>(s.size()));
+    }
+    addArray(TEXTOID, data);
+}
+
 void Command::addText(char const* const s, size_t const len) {
     setMeta(0, static_cast<int>(len), 0);
     storeData(s, len);
 }
 
+void Command::addArray(Oid const elem_id, std::vector<char> const& data) {
+    auto const id = [elem_id]() -> Oid {
+        switch (elem_id) {
+            case BOOLOID: {
+                return BOOLARRAYOID;
+            }
+            case INT2OID: {
+                return INT2ARRAYOID;
+            }
+            case INT4OID: {
+                return INT4ARRAYOID;
+            }
+            case INT8OID: {
+                return INT8ARRAYOID;
+            }
+            case FLOAT4OID: {
+                return FLOAT4ARRAYOID;
+            }
+            case FLOAT8OID: {
+                return FLOAT8ARRAYOID;
+            }
+            default: {
+                break;
+            }
+        }
+        return TEXTARRAYOID;
+    }();
+
+    setMeta(id, static_cast<int>(data.size()), 1);
+    storeData(data.data(), data.size());
+}
+
+// One-dimensional array without nulls: a header and a length-prefixed items.
+std::vector<char> Command::makeArray(Oid const elem_id, size_t const size) {
+    int32_t const header[] = {
+        internal::orderBytes<int32_t>(1),
+        internal::orderBytes<int32_t>(0),
+        internal::orderBytes(static_cast<int32_t>(elem_id)),
+        internal::orderBytes(static_cast<int32_t>(size)),
+        internal::orderBytes<int32_t>(1),
+    };
+
+    std::vector<char> data(sizeof(header));
+    memcpy(data.data(), header, sizeof(header));
+    return data;
+}
+
+void Command::appendArrayItem(std::vector<char>& data, void const* const item, int32_t const len) {
+    auto const old_len = data.size();
+    auto const net_len = internal::orderBytes(len);
+    data.resize(old_len + sizeof(net_len) + len);
+    memcpy(data.data() + old_len, &net_len, sizeof(net_len));
+    memcpy(data.data() + old_len + sizeof(net_len), item, static_cast<size_t>(len));
+}
+
 void Command::setMeta(Oid const id, int const len, int const fmt) {
     types_.push_back(id);
     lengths_.push_back(len);
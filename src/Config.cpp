@@ -98,6 +98,23 @@ Config::Builder& Config::Builder::port(int const val) {
     return setNumber("port", val);
 }
 
+Config::Builder& Config::Builder::replication(ReplicationMode const val) {
+    return set("replication", [val] {
+        switch (val) {
+            case ReplicationMode::PHYSICAL: {
+                return "true";
+            }
+            case ReplicationMode::LOGICAL: {
+                return "database";
+            }
+            case ReplicationMode::DEFAULT: {
+                break;
+            }
+        }
+        return "false";
+    }());
+}
+
 Config::Builder& Config::Builder::requirepeer(std::string const& val) {
     return set("requirepeer", val);
 }
@@ -1,5 +1,8 @@
 #include <postgres/Connection.h>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <postgres/Config.h>
 #include <postgres/Consumer.h>
 #include <postgres/Error.h>
@@ -88,7 +91,8 @@ Receiver Connection::send(PrepareData const& prep) {
                                   prep.name.data(),
                                   prep.statement.data(),
                                   static_cast<int>(prep.types.size()),
-                                  prep.types.data())};
+                                  prep.types.data()),
+                    abandon_};
 }
 
 Receiver Connection::send(Command const& cmd) {
@@ -100,7 +104,8 @@ Receiver Connection::send(Command const& cmd) {
                                       cmd.values(),
                                       cmd.lengths(),
                                       cmd.formats(),
-                                      RESULT_FORMAT)};
+                                      RESULT_FORMAT),
+                    abandon_};
 }
 
 Receiver Connection::send(PreparedCommand const& cmd) {
@@ -111,11 +116,12 @@ Receiver Connection::send(PreparedCommand const& cmd) {
                                         cmd.values(),
                                         cmd.lengths(),
                                         cmd.formats(),
-                                        RESULT_FORMAT)};
+                                        RESULT_FORMAT),
+                    abandon_};
 }
 
 Consumer Connection::sendRaw(std::string_view const stmt) {
-    return Consumer{handle_, PQsendQuery(native(), stmt.data())};
+    return Consumer{handle_, PQsendQuery(native(), stmt.data()), abandon_};
 }
 
 Receiver Connection::iter(Command const& cmd) {
@@ -130,11 +136,289 @@ Receiver Connection::iter(PreparedCommand const& cmd) {
     return rcvr;
 }
 
+Stream Connection::stream(Command const& cmd, int const chunk_size) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < chunk_size, "bad chunk size: " << chunk_size);
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+    auto const rcvr = std::make_shared<Receiver>(send(cmd));
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQsetChunkedRowsMode(native(), chunk_size) == 1,
+                         "fail to set chunked rows mode: " << message());
+    return Stream{[rcvr] {
+        return rcvr->receive();
+    }, nullptr};
+#else
+    auto const name  = makeCursorName();
+    auto       close = declare(cmd, name);
+    auto const fetch = "FETCH " + std::to_string(chunk_size) + " FROM " + name;
+    return Stream{[handle = handle_, fetch] {
+        return Result{PQexecParams(handle.get(),
+                                   fetch.data(),
+                                   0,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   nullptr,
+                                   RESULT_FORMAT)};
+    }, std::move(close)};
+#endif
+}
+
+Stream Connection::cursor(Command const& cmd, int const batch_size, size_t const max_memory) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < batch_size, "bad batch size: " << batch_size);
+
+    struct State {
+        std::shared_ptr<PGconn> handle;
+        std::string             name;
+        int                     batch_size;
+        bool                    is_sent;
+    };
+
+    auto const name  = makeCursorName();
+    auto       close = declare(cmd, name);
+    // With a memory limit the first batch is a single row, telling the row size.
+    auto const first = (0 < max_memory) ? 1 : batch_size;
+    auto const state = std::make_shared<State>(State{handle_, name, first, false});
+
+    auto const send = [state] {
+        auto const stmt = "FETCH " + std::to_string(state->batch_size) + " FROM " + state->name;
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             PQsendQueryParams(state->handle.get(),
+                                               stmt.data(),
+                                               0,
+                                               nullptr,
+                                               nullptr,
+                                               nullptr,
+                                               nullptr,
+                                               RESULT_FORMAT) == 1,
+                             "fail to send statement: " << PQerrorMessage(state->handle.get()));
+        state->is_sent = true;
+    };
+
+    // Wait for the batch in flight, which must be followed by the terminating null.
+    auto const receive = [state] {
+        auto const conn = state->handle.get();
+        auto const res  = PQgetResult(conn);
+        while (auto const tail = PQgetResult(conn)) {
+            PQclear(tail);
+        }
+        state->is_sent = false;
+        return Result{res};
+    };
+
+    return Stream{[state, send, receive, batch_size, max_memory] {
+        if (!state->is_sent) {
+            send();
+        }
+
+        auto       res  = receive();
+        auto const rows = res.size();
+        if (rows == 0) {
+            return res;
+        }
+
+        // Both the current batch and the next one have to fit in memory.
+        if (0 < max_memory) {
+            auto const row_size = std::max<size_t>(PQresultMemorySize(res.native()) / rows, 1);
+            auto const limit    = max_memory / 2 / row_size;
+            state->batch_size = static_cast<int>(std::clamp<size_t>(limit, 1, batch_size));
+        }
+        send();
+        return res;
+    }, [state, close = std::move(close)] {
+        // The batch in flight is of no interest, even if it has failed.
+        if (state->is_sent) {
+            while (auto const res = PQgetResult(state->handle.get())) {
+                PQclear(res);
+            }
+            state->is_sent = false;
+        }
+        close();
+    }};
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+Result Connection::pipeline(std::function<void()> const& queue) {
+    auto const conn = native();
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQenterPipelineMode(conn) == 1,
+                         "fail to enter pipeline mode: " << message());
+
+    std::exception_ptr failure{};
+    try {
+        enqueue("BEGIN");
+        queue();
+        enqueue("COMMIT");
+    } catch (...) {
+        failure = std::current_exception();
+    }
+
+    // Once a statement fails the rest up to the sync point are skipped by the server,
+    // leaving the transaction aborted.
+    std::vector<std::unique_ptr<PGresult, void (*)(PGresult*)>> results{};
+    if (PQpipelineSync(conn) == 1) {
+        while (true) {
+            auto const res = PQgetResult(conn);
+            if (res == nullptr) {
+                if (!isOk()) {
+                    break;
+                }
+                continue;
+            }
+            if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+                PQclear(res);
+                break;
+            }
+            results.emplace_back(res, PQclear);
+        }
+    }
+    PQexitPipelineMode(conn);
+    if (PQtransactionStatus(conn) != PQTRANS_IDLE) {
+        PQclear(PQexec(conn, "ROLLBACK"));
+    }
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    for (auto& res : results) {
+        if (PQresultStatus(res.get()) == PGRES_FATAL_ERROR) {
+            // Throws the error of the statement which has aborted the transaction.
+            Status{res.release()};
+        }
+    }
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         2 < results.size(),
+                         "fail to execute transaction: " << message());
+    // The last one is the result of COMMIT.
+    return Result{results[results.size() - 2].release()};
+}
+
+void Connection::enqueue(PrepareData const& prep) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQsendPrepare(native(),
+                                       prep.name.data(),
+                                       prep.statement.data(),
+                                       static_cast<int>(prep.types.size()),
+                                       prep.types.data()) == 1,
+                         "fail to send statement: " << message());
+}
+
+void Connection::enqueue(Command const& cmd) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQsendQueryParams(native(),
+                                           cmd.statement(),
+                                           cmd.count(),
+                                           cmd.types(),
+                                           cmd.values(),
+                                           cmd.lengths(),
+                                           cmd.formats(),
+                                           RESULT_FORMAT) == 1,
+                         "fail to send statement: " << message());
+}
+
+void Connection::enqueue(PreparedCommand const& cmd) {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQsendQueryPrepared(native(),
+                                             cmd.statement(),
+                                             cmd.count(),
+                                             cmd.values(),
+                                             cmd.lengths(),
+                                             cmd.formats(),
+                                             RESULT_FORMAT) == 1,
+                         "fail to send statement: " << message());
+}
+#endif
+
+std::string Connection::makeCursorName() {
+    static std::atomic<uint64_t> cursors{0};
+    return "postgres_cxx_cursor_" + std::to_string(++cursors);
+}
+
+std::function<void()> Connection::declare(Command const& cmd, std::string const& name) {
+    auto const is_idle = PQtransactionStatus(native()) == PQTRANS_IDLE;
+    auto const decl    = "DECLARE " + name + " NO SCROLL CURSOR FOR " + cmd.statement();
+    if (is_idle) {
+        execRaw("BEGIN");
+    }
+
+    try {
+        Status{PQexecParams(native(),
+                            decl.data(),
+                            cmd.count(),
+                            cmd.types(),
+                            cmd.values(),
+                            cmd.lengths(),
+                            cmd.formats(),
+                            RESULT_FORMAT)};
+    } catch (...) {
+        if (is_idle) {
+            PQclear(PQexec(native(), "ROLLBACK"));
+        }
+        throw;
+    }
+
+    auto const close = is_idle ? std::string{"COMMIT"} : ("CLOSE " + name);
+    return [handle = handle_, close] {
+        PQclear(PQexec(handle.get(), close.data()));
+    };
+}
+
 Transaction Connection::begin() {
     exec("BEGIN");
     return Transaction{*this};
 }
 
+Transaction Connection::begin(IsolationLevel const level, bool const is_read_only) {
+    std::string stmt = "BEGIN";
+    switch (level) {
+        case IsolationLevel::DEFAULT: {
+            break;
+        }
+        case IsolationLevel::READ_COMMITTED: {
+            stmt += " ISOLATION LEVEL READ COMMITTED";
+            break;
+        }
+        case IsolationLevel::REPEATABLE_READ: {
+            stmt += " ISOLATION LEVEL REPEATABLE READ";
+            break;
+        }
+        case IsolationLevel::SERIALIZABLE: {
+            stmt += " ISOLATION LEVEL SERIALIZABLE";
+            break;
+        }
+    }
+    if (is_read_only) {
+        stmt += " READ ONLY";
+    }
+    exec(stmt);
+    return Transaction{*this};
+}
+
+ReplicationStream Connection::replicate(std::string const& slot,
+                                        std::vector<std::string> const& publications,
+                                        Lsn const start) {
+    std::string names{};
+    for (auto const& name : publications) {
+        if (!names.empty()) {
+            names += ',';
+        }
+        names += escId(name);
+    }
+
+    auto const stmt = "START_REPLICATION SLOT "
+                      + escId(slot)
+                      + " LOGICAL "
+                      + formatLsn(start)
+                      + " (proto_version '1', publication_names "
+                      + esc(names)
+                      + ")";
+    return ReplicationStream{handle_, PQexec(native(), stmt.data())};
+}
+
+void Connection::abandonPolicy(AbandonPolicy const val) {
+    abandon_ = val;
+}
+
 bool Connection::reset() {
     PQreset(native());
     return isOk();
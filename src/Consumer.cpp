@@ -5,8 +5,8 @@
 
 namespace postgres {
 
-Consumer::Consumer(std::shared_ptr<PGconn> handle, int const is_ok)
-    : handle_{std::move(handle)}, is_ok_{is_ok == 1} {
+Consumer::Consumer(std::shared_ptr<PGconn> handle, int const is_ok, AbandonPolicy const abandon)
+    : handle_{std::move(handle)}, is_ok_{is_ok == 1}, abandon_{abandon} {
     _POSTGRES_CXX_ASSERT(RuntimeError,
                          isOk(),
                          "fail to send statement: " << PQerrorMessage(handle_.get()));
@@ -17,7 +17,14 @@ Consumer::Consumer(Consumer&& other) noexcept = default;
 Consumer& Consumer::operator=(Consumer&& other) noexcept = default;
 
 Consumer::~Consumer() noexcept {
-    while (!consume().isDone()) {
+    auto const conn = handle_.get();
+    if ((abandon_ == AbandonPolicy::CANCEL) && (PQtransactionStatus(conn) == PQTRANS_ACTIVE)) {
+        cancel();
+    }
+
+    // Errors are of no interest here, and a canceled statement always ends up with one.
+    while (auto const res = PQgetResult(conn)) {
+        PQclear(res);
     }
 }
 
@@ -29,6 +36,17 @@ bool Consumer::isOk() const {
     return is_ok_;
 }
 
+bool Consumer::cancel() {
+    std::unique_ptr<PGcancel, void (*)(PGcancel*)> const cncl{PQgetCancel(handle_.get()),
+                                                              PQfreeCancel};
+    if (!cncl) {
+        return false;
+    }
+
+    char err[256];
+    return PQcancel(cncl.get(), err, sizeof(err)) == 1;
+}
+
 bool Consumer::isBusy() {
     PQconsumeInput(handle_.get());
     return PQisBusy(handle_.get()) == 1;
@@ -1,6 +1,7 @@
 #include <postgres/Context.h>
 
 #include <thread>
+#include <postgres/Cache.h>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
 
@@ -9,9 +10,23 @@ namespace postgres {
 Context::Context()
     : cfg_{Config::build()},
       max_idle_{0},
+      max_life_{0},
+      validation_{0},
       max_concur_{static_cast<int>(std::thread::hardware_concurrency())},
+      min_concur_{0},
+      target_wait_{0},
+      scaling_{0},
+      max_connecting_{1},
+      min_backoff_{std::chrono::milliseconds{100}},
+      max_backoff_{std::chrono::seconds{10}},
+      max_attempts_{5},
       max_queue_{0},
-      shut_pol_{ShutdownPolicy::GRACEFUL} {
+      aging_{0},
+      low_mark_{0},
+      high_mark_{0},
+      shut_pol_{ShutdownPolicy::GRACEFUL},
+      abandon_pol_{AbandonPolicy::DRAIN},
+      queue_pol_{QueuePolicy::FIFO} {
 }
 
 Context::Context(Context&& other) noexcept = default;
@@ -22,6 +37,7 @@ Context::~Context() noexcept = default;
 
 Connection Context::connect() const {
     auto conn = uri_.empty() ? Connection{cfg_} : Connection{uri_};
+    conn.abandonPolicy(abandon_pol_);
     for (auto const& prep : preparings_) {
         conn.exec(prep);
     }
@@ -32,18 +48,88 @@ Context::Duration Context::idleTimeout() const {
     return max_idle_;
 }
 
+Context::Duration Context::maxLifetime() const {
+    return max_life_;
+}
+
+Context::Duration Context::validationInterval() const {
+    return validation_;
+}
+
 int Context::maxConcurrency() const {
     return max_concur_;
 }
 
+int Context::minConcurrency() const {
+    return min_concur_;
+}
+
+Context::Duration Context::targetWait() const {
+    return target_wait_;
+}
+
+Context::Duration Context::scalingInterval() const {
+    return scaling_;
+}
+
+int Context::maxConnecting() const {
+    return max_connecting_;
+}
+
+Context::Duration Context::minBackoff() const {
+    return min_backoff_;
+}
+
+Context::Duration Context::maxBackoff() const {
+    return max_backoff_;
+}
+
+int Context::maxConnectAttempts() const {
+    return max_attempts_;
+}
+
 int Context::maxQueueSize() const {
     return max_queue_;
 }
 
+int Context::maxQueueSize(Priority const prio) const {
+    auto const it = max_lanes_.find(prio);
+    return (it == max_lanes_.end()) ? 0 : it->second;
+}
+
+Context::Duration Context::agingInterval() const {
+    return aging_;
+}
+
+int Context::lowWatermark() const {
+    return low_mark_;
+}
+
+int Context::highWatermark() const {
+    return high_mark_;
+}
+
 ShutdownPolicy Context::shutdownPolicy() const {
     return shut_pol_;
 }
 
+AbandonPolicy Context::abandonPolicy() const {
+    return abandon_pol_;
+}
+
+QueuePolicy Context::queuePolicy() const {
+    return queue_pol_;
+}
+
+FlowConfig const& Context::flow(std::string const& id) const {
+    auto const it = flows_.find(id);
+    return (it == flows_.end()) ? default_flow_ : it->second;
+}
+
+std::shared_ptr<Cache> Context::cache() const {
+    return cache_;
+}
+
 Context::Builder::Builder() = default;
 
 Context::Builder::Builder(Context::Builder&& other) noexcept = default;
@@ -73,24 +159,136 @@ Context::Builder& Context::Builder::idleTimeout(Context::Duration const val) {
     return *this;
 }
 
+Context::Builder& Context::Builder::maxLifetime(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad max lifetime: " << val.count());
+    ctx_.max_life_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::validationInterval(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad validation interval: " << val.count());
+    ctx_.validation_ = val;
+    return *this;
+}
+
 Context::Builder& Context::Builder::maxConcurrency(int const val) {
     _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad concurrency: " << val);
     ctx_.max_concur_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::minConcurrency(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad concurrency: " << val);
+    ctx_.min_concur_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::targetWait(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad target wait: " << val.count());
+    ctx_.target_wait_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::scalingInterval(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad scaling interval: " << val.count());
+    ctx_.scaling_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::maxConnecting(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad connecting limit: " << val);
+    ctx_.max_connecting_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::connectBackoff(Context::Duration const min,
+                                                   Context::Duration const max) {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 < min.count()) && (min <= max),
+                         "bad connect backoff: " << min.count() << ", " << max.count());
+    ctx_.min_backoff_ = min;
+    ctx_.max_backoff_ = max;
+    return *this;
+}
+
+Context::Builder& Context::Builder::maxConnectAttempts(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad connect attempts: " << val);
+    ctx_.max_attempts_ = val;
+    return *this;
+}
+
 Context::Builder& Context::Builder::maxQueueSize(int const val) {
     _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad queue size: " << val);
     ctx_.max_queue_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::maxQueueSize(Priority const prio, int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad queue size: " << val);
+    ctx_.max_lanes_[prio] = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::agingInterval(Context::Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val.count(), "bad aging interval: " << val.count());
+    ctx_.aging_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::watermarks(int const low, int const high) {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 <= low) && (low < high),
+                         "bad watermarks: " << low << ", " << high);
+    ctx_.low_mark_  = low;
+    ctx_.high_mark_ = high;
+    return *this;
+}
+
 Context::Builder& Context::Builder::shutdownPolicy(ShutdownPolicy const val) {
     ctx_.shut_pol_ = val;
     return *this;
 }
 
+Context::Builder& Context::Builder::abandonPolicy(AbandonPolicy const val) {
+    ctx_.abandon_pol_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::queuePolicy(QueuePolicy const val) {
+    ctx_.queue_pol_ = val;
+    return *this;
+}
+
+Context::Builder& Context::Builder::flow(std::string id, FlowConfig const cfg) {
+    validate(cfg);
+    ctx_.flows_[std::move(id)] = cfg;
+    return *this;
+}
+
+Context::Builder& Context::Builder::defaultFlow(FlowConfig const cfg) {
+    validate(cfg);
+    ctx_.default_flow_ = cfg;
+    return *this;
+}
+
+Context::Builder& Context::Builder::cache(std::shared_ptr<Cache> val) {
+    ctx_.cache_ = std::move(val);
+    return *this;
+}
+
+void Context::Builder::validate(FlowConfig const& cfg) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= cfg.weight, "bad flow weight: " << cfg.weight);
+    _POSTGRES_CXX_ASSERT(LogicError, 0.0 <= cfg.rate, "bad flow rate: " << cfg.rate);
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= cfg.burst, "bad flow burst: " << cfg.burst);
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         0 <= cfg.max_concurrency,
+                         "bad flow concurrency: " << cfg.max_concurrency);
+}
+
 Context Context::Builder::build() {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         ctx_.min_concur_ <= ctx_.max_concur_,
+                         "bad concurrency bounds: " << ctx_.min_concur_ << ", " << ctx_.max_concur_);
     return std::move(ctx_);
 }
 
@@ -0,0 +1,90 @@
+#include <postgres/internal/Controller.h>
+
+#include <utility>
+#include <postgres/internal/Backoff.h>
+#include <postgres/Context.h>
+
+namespace postgres::internal {
+
+Controller::Clock::duration Controller::backoff(Context const&    ctx,
+                                                int const         failures,
+                                                std::minstd_rand& rnd) {
+    return std::chrono::duration_cast<Clock::duration>(
+        internal::backoff(ctx.minBackoff(), ctx.maxBackoff(), failures + 1, rnd));
+}
+
+Controller::Controller(std::shared_ptr<Context const> ctx)
+    : ctx_{std::move(ctx)}, rnd_{std::random_device{}()} {
+}
+
+Controller::~Controller() noexcept = default;
+
+void Controller::onWait(Clock::duration const wait) {
+    wait_ += (wait - wait_) / SMOOTHING;
+}
+
+void Controller::onLoad(int const busy, int const size) {
+    auto const val = (0 < size) ? static_cast<double>(busy) / size : 0.0;
+    load_ += (val - load_) / SMOOTHING;
+}
+
+bool Controller::grow(int const size, int const starting, Clock::time_point const now) {
+    auto const total = size + starting;
+    if ((ctx_->maxConcurrency() <= total) || (ctx_->maxConnecting() <= starting)) {
+        return false;
+    }
+
+    // Jobs must not be left without workers, so the first one is not delayed.
+    if (0 < total) {
+        if ((now < retry_) || (now < grown_ + ctx_->scalingInterval())) {
+            return false;
+        }
+        // Nor is the pool kept below its minimum.
+        auto const target = ctx_->targetWait();
+        if ((ctx_->minConcurrency() <= total) && (0 < target.count()) && (wait_ <= target)) {
+            return false;
+        }
+    }
+
+    grown_   = now;
+    changed_ = now;
+    return true;
+}
+
+// Waiting for an idle timeout since the last change of any direction
+// prevents the pool from oscillating.
+bool Controller::shrink(int const size, Clock::time_point const now) {
+    if ((size <= ctx_->minConcurrency()) || (LOW_LOAD <= load_)) {
+        return false;
+    }
+    if (now < changed_ + ctx_->idleTimeout()) {
+        return false;
+    }
+
+    changed_ = now;
+    return true;
+}
+
+Controller::Clock::duration Controller::fail(Clock::time_point const now) {
+    auto const delay = backoff(*ctx_, failures_++, rnd_);
+    retry_ = now + delay;
+    return delay;
+}
+
+void Controller::succeed() {
+    failures_ = 0;
+}
+
+int Controller::failures() const {
+    return failures_;
+}
+
+Controller::Clock::duration Controller::wait() const {
+    return wait_;
+}
+
+double Controller::load() const {
+    return load_;
+}
+
+}  // namespace postgres::internal
@@ -1,12 +1,28 @@
 #include <postgres/internal/Dispatcher.h>
 
+#include <map>
+#include <mutex>
+#include <random>
+#include <postgres/internal/Controller.h>
 #include <postgres/internal/Worker.h>
+#include <postgres/Connection.h>
 #include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/Result.h>
 
 namespace postgres::internal {
 
+struct Dispatcher::Flights {
+    std::map<std::string, std::shared_future<Result>> futures;
+    std::mutex                                        mtx;
+};
+
 Dispatcher::Dispatcher(std::shared_ptr<Context const> ctx, std::shared_ptr<IChannel> chan)
-    : ctx_{std::move(ctx)}, chan_{std::move(chan)} {
+    : ctx_{std::move(ctx)},
+      chan_{std::move(chan)},
+      flights_{std::make_shared<Flights>()},
+      watchdog_{std::make_shared<Watchdog>()},
+      workers_(static_cast<size_t>(ctx_->maxConcurrency())) {
 }
 
 Dispatcher::~Dispatcher() noexcept {
@@ -25,6 +41,80 @@ Dispatcher::~Dispatcher() noexcept {
     }
 }
 
+std::shared_future<Result> Dispatcher::share(std::string key,
+                                             std::function<Result(Connection&)> job) {
+    std::unique_lock guard{flights_->mtx};
+    auto const       it = flights_->futures.find(key);
+    if (it != flights_->futures.end()) {
+        return it->second;
+    }
+
+    auto const prom = std::make_shared<std::promise<Result>>();
+    auto const res  = prom->get_future().share();
+    flights_->futures.emplace(key, res);
+    guard.unlock();
+
+    // The flight is over once the result is known, whichever way it is obtained.
+    auto const land = [flights = flights_, key] {
+        std::lock_guard guard{flights->mtx};
+        flights->futures.erase(key);
+    };
+    try {
+        scale(chan_->send(Job{[prom, job = std::move(job), land](Connection& conn) {
+            try {
+                prom->set_value(job(conn));
+            } catch (...) {
+                prom->set_exception(std::current_exception());
+            }
+            land();
+        }, Priority::NORMAL, Job::Clock::time_point::max(), {}, nullptr, [prom, land](std::exception_ptr err) {
+            prom->set_exception(std::move(err));
+            land();
+        }}));
+    } catch (...) {
+        guard.lock();
+        flights_->futures.erase(key);
+        throw;
+    }
+    return res;
+}
+
+QueueStats Dispatcher::stats() const {
+    return chan_->stats();
+}
+
+std::exception_ptr Dispatcher::timeout(char const* const msg) {
+    try {
+        _POSTGRES_CXX_FAIL(TimeoutError, msg);
+    } catch (...) {
+        return std::current_exception();
+    }
+}
+
+bool Dispatcher::isTransient(Connection& conn, std::exception_ptr const& err) {
+    if (!conn.isOk()) {
+        return true;
+    }
+
+    try {
+        std::rethrow_exception(err);
+    } catch (SqlError const& e) {
+        // Connection exceptions and the server shutting down.
+        auto const& state = e.sqlState();
+        return (state.compare(0, 2, "08") == 0) ||
+               (state == "57P01") ||
+               (state == "57P02") ||
+               (state == "57P03");
+    } catch (...) {
+        return false;
+    }
+}
+
+Job::Clock::duration Dispatcher::delay(Context const& ctx, int const attempt) {
+    thread_local std::minstd_rand rnd{std::random_device{}()};
+    return Controller::backoff(ctx, attempt, rnd);
+}
+
 void Dispatcher::scale(std::tuple<bool, Worker*> const params) {
     auto const[is_sent, recycled] = params;
     if (is_sent) {
@@ -36,17 +126,21 @@ void Dispatcher::scale(std::tuple<bool, Worker*> const params) {
         return;
     }
 
-    if (size() == ctx_->maxConcurrency()) {
-        return;
-    }
+    // Reserve a slot first, so concurrent senders never spawn more workers than allowed.
+    auto idx = spawned_.load();
+    do {
+        if (idx == ctx_->maxConcurrency()) {
+            return;
+        }
+    } while (!spawned_.compare_exchange_weak(idx, idx + 1));
 
-    auto worker = std::make_unique<internal::Worker>(ctx_, chan_);
+    auto& worker = workers_[static_cast<size_t>(idx)];
+    worker = std::make_unique<internal::Worker>(ctx_, chan_);
     worker->run();
-    workers_.push_back(std::move(worker));
 }
 
 inline int Dispatcher::size() const {
-    return static_cast<int>(workers_.size());
+    return spawned_.load();
 }
 
 }  // namespace postgres::internal
@@ -0,0 +1,70 @@
+#include <postgres/internal/EpollPoller.h>
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+static uint32_t toEpoll(short const events) {
+    return ((events & POLLIN) ? EPOLLIN : 0u) | ((events & POLLOUT) ? EPOLLOUT : 0u);
+}
+
+static short fromEpoll(uint32_t const events) {
+    return static_cast<short>(((events & EPOLLIN) ? POLLIN : 0)
+                              | ((events & EPOLLOUT) ? POLLOUT : 0)
+                              | ((events & EPOLLERR) ? POLLERR : 0)
+                              | ((events & EPOLLHUP) ? POLLHUP : 0));
+}
+
+EpollPoller::EpollPoller()
+    : fd_{::epoll_create1(EPOLL_CLOEXEC)} {
+    _POSTGRES_CXX_ASSERT(RuntimeError, 0 <= fd_, "fail to create epoll: " << strerror(errno));
+}
+
+EpollPoller::~EpollPoller() noexcept {
+    ::close(fd_);
+}
+
+EventBackend EpollPoller::backend() const {
+    return EventBackend::EPOLL;
+}
+
+void EpollPoller::watch(int const fd, short const events) {
+    auto const it = watched_.find(fd);
+    if (events == 0) {
+        if (it != watched_.end()) {
+            ::epoll_ctl(fd_, EPOLL_CTL_DEL, fd, nullptr);
+            watched_.erase(it);
+        }
+        return;
+    }
+    if ((it != watched_.end()) && (it->second == events)) {
+        return;
+    }
+
+    epoll_event ev{};
+    ev.events  = toEpoll(events);
+    ev.data.fd = fd;
+    auto const op = (it == watched_.end()) ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         ::epoll_ctl(fd_, op, fd, &ev) == 0,
+                         "fail to watch descriptor: " << strerror(errno));
+    watched_[fd] = events;
+}
+
+void EpollPoller::wait(std::vector<Event>& out) {
+    epoll_event evs[64];
+    auto        n = -1;
+    while ((n = ::epoll_wait(fd_, evs, 64, -1)) < 0) {
+        _POSTGRES_CXX_ASSERT(RuntimeError, errno == EINTR, "fail to wait: " << strerror(errno));
+    }
+    for (auto i = 0; i < n; ++i) {
+        out.push_back(Event{evs[i].data.fd, fromEpoll(evs[i].events)});
+    }
+}
+
+}  // namespace postgres::internal
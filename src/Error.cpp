@@ -48,4 +48,36 @@ RuntimeError& RuntimeError::operator=(RuntimeError&& other) noexcept = default;
 
 RuntimeError::~RuntimeError() noexcept = default;
 
+SqlError::SqlError(std::string msg, std::string state)
+    : RuntimeError{std::move(msg)}, state_{std::move(state)} {
+}
+
+SqlError::SqlError(SqlError const& other) = default;
+
+SqlError& SqlError::operator=(SqlError const& other) = default;
+
+SqlError::SqlError(SqlError&& other) noexcept = default;
+
+SqlError& SqlError::operator=(SqlError&& other) noexcept = default;
+
+SqlError::~SqlError() noexcept = default;
+
+std::string const& SqlError::sqlState() const {
+    return state_;
+}
+
+TimeoutError::TimeoutError(std::string msg)
+    : RuntimeError{std::move(msg)} {
+}
+
+TimeoutError::TimeoutError(TimeoutError const& other) = default;
+
+TimeoutError& TimeoutError::operator=(TimeoutError const& other) = default;
+
+TimeoutError::TimeoutError(TimeoutError&& other) noexcept = default;
+
+TimeoutError& TimeoutError::operator=(TimeoutError&& other) noexcept = default;
+
+TimeoutError::~TimeoutError() noexcept = default;
+
 }  // namespace postgres
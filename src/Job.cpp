@@ -1 +1,81 @@
 #include <postgres/internal/Job.h>
+
+#include <utility>
+
+namespace postgres::internal {
+
+Job::Job() = default;
+
+Job::Job(std::nullptr_t) {
+}
+
+Job::Job(Func func,
+         Priority const prio,
+         Clock::time_point const deadline,
+         std::string flow,
+         std::function<void()> expire,
+         std::function<void(std::exception_ptr)> fail)
+    : func_{std::move(func)},
+      prio_{prio},
+      deadline_{deadline},
+      flow_{std::move(flow)},
+      expire_{std::move(expire)},
+      fail_{std::move(fail)} {
+}
+
+Job::Job(Job const& other) = default;
+
+Job& Job::operator=(Job const& other) = default;
+
+Job::Job(Job&& other) noexcept = default;
+
+Job& Job::operator=(Job&& other) noexcept = default;
+
+Job::~Job() noexcept = default;
+
+Job::operator bool() const {
+    return static_cast<bool>(func_);
+}
+
+void Job::operator()(Connection& conn) const {
+    func_(conn);
+}
+
+void Job::swap(Job& other) noexcept {
+    std::swap(func_, other.func_);
+    std::swap(prio_, other.prio_);
+    std::swap(deadline_, other.deadline_);
+    std::swap(flow_, other.flow_);
+    std::swap(expire_, other.expire_);
+    std::swap(fail_, other.fail_);
+}
+
+bool Job::isExpired(Clock::time_point const now) const {
+    return deadline_ <= now;
+}
+
+void Job::expire() const {
+    if (expire_) {
+        expire_();
+    }
+}
+
+void Job::fail(std::exception_ptr const& err) const {
+    if (fail_) {
+        fail_(err);
+    }
+}
+
+Priority Job::priority() const {
+    return prio_;
+}
+
+Job::Clock::time_point Job::deadline() const {
+    return deadline_;
+}
+
+std::string const& Job::flow() const {
+    return flow_;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,68 @@
+#include <postgres/JobOptions.h>
+
+#include <utility>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+JobOptions::JobOptions()
+    : prio_{Priority::NORMAL}, retries_{0} {
+}
+
+JobOptions::JobOptions(JobOptions const& other) = default;
+
+JobOptions& JobOptions::operator=(JobOptions const& other) = default;
+
+JobOptions::JobOptions(JobOptions&& other) noexcept = default;
+
+JobOptions& JobOptions::operator=(JobOptions&& other) noexcept = default;
+
+JobOptions::~JobOptions() noexcept = default;
+
+JobOptions& JobOptions::priority(Priority const val) {
+    prio_ = val;
+    return *this;
+}
+
+JobOptions& JobOptions::timeout(Duration const val) {
+    timeout_ = val;
+    return *this;
+}
+
+JobOptions& JobOptions::flow(std::string val) {
+    flow_ = std::move(val);
+    return *this;
+}
+
+JobOptions& JobOptions::block(Duration const val) {
+    block_ = val;
+    return *this;
+}
+
+JobOptions& JobOptions::retries(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 <= val, "bad retries: " << val);
+    retries_ = val;
+    return *this;
+}
+
+Priority JobOptions::priority() const {
+    return prio_;
+}
+
+std::optional<JobOptions::Duration> const& JobOptions::timeout() const {
+    return timeout_;
+}
+
+std::string const& JobOptions::flow() const {
+    return flow_;
+}
+
+std::optional<JobOptions::Duration> const& JobOptions::block() const {
+    return block_;
+}
+
+int JobOptions::retries() const {
+    return retries_;
+}
+
+}  // namespace postgres
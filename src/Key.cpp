@@ -0,0 +1,42 @@
+#include <postgres/internal/Key.h>
+
+#include <cstring>
+#include <postgres/Command.h>
+#include <postgres/PreparedCommand.h>
+
+namespace postgres::internal {
+
+static std::string makeKey(char const kind, Command const& cmd) {
+    std::string key{kind};
+    key += cmd.statement();
+
+    auto const append = [&key](auto const val) {
+        key.append(reinterpret_cast<char const*>(&val), sizeof(val));
+    };
+
+    for (auto i = 0; i < cmd.count(); ++i) {
+        auto const val = cmd.values()[i];
+        append(cmd.types()[i]);
+        append(cmd.formats()[i]);
+        if (!val) {
+            append(-1);
+            continue;
+        }
+
+        // Text arguments are not necessarily supplied with their lengths.
+        auto const len = (cmd.formats()[i] == 0) ? strlen(val) : cmd.lengths()[i];
+        append(static_cast<int>(len));
+        key.append(val, len);
+    }
+    return key;
+}
+
+std::string makeKey(Command const& cmd) {
+    return makeKey('C', cmd);
+}
+
+std::string makeKey(PreparedCommand const& cmd) {
+    return makeKey('P', cmd);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,167 @@
+#include <postgres/internal/Listener.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Notification.h>
+#include <postgres/Status.h>
+
+namespace postgres::internal {
+
+Listener::Listener(Factory connect, NotifyCallback on_notify, ResetCallback on_reset)
+    : connect_{std::move(connect)}, on_notify_{std::move(on_notify)}, on_reset_{std::move(on_reset)} {
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) == 0,
+                         "fail to create pipe: " << strerror(errno));
+    thread_ = std::thread([this] {
+        run();
+    });
+}
+
+Listener::~Listener() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+    }
+    wake();
+    thread_.join();
+    ::close(pipe_[0]);
+    ::close(pipe_[1]);
+}
+
+void Listener::listen(std::string const& channel) {
+    {
+        std::lock_guard guard{mtx_};
+        if (!channels_.insert(channel).second) {
+            return;
+        }
+        pending_.push_back(channel);
+    }
+    wake();
+}
+
+void Listener::unlisten(std::string const& channel) {
+    {
+        std::lock_guard guard{mtx_};
+        if (channels_.erase(channel) == 0) {
+            return;
+        }
+        pending_.erase(std::remove(pending_.begin(), pending_.end(), channel), pending_.end());
+        listening_.erase(channel);
+        dropped_.push_back(channel);
+    }
+    wake();
+}
+
+bool Listener::isListening(std::string const& channel) {
+    std::lock_guard guard{mtx_};
+    return listening_.count(channel) != 0;
+}
+
+void Listener::run() {
+    auto failures = 0;
+    while (true) {
+        {
+            std::lock_guard guard{mtx_};
+            if (is_stopped_) {
+                return;
+            }
+            pending_.assign(channels_.begin(), channels_.end());
+            dropped_.clear();
+            listening_.clear();
+        }
+
+        try {
+            auto conn = connect_();
+            if (sync(conn)) {
+                failures = 0;
+                on_reset_();
+                serve(conn);
+            }
+        } catch (std::exception const&) {
+            // Connect again after a pause.
+        }
+        pause(++failures);
+    }
+}
+
+void Listener::serve(Connection& conn) {
+    auto const handle = conn.native();
+    while (sync(conn)) {
+        while (auto const note = PQnotifies(handle)) {
+            Notification item{note->relname, note->extra, note->be_pid};
+            PQfreemem(note);
+            on_notify_(std::move(item));
+        }
+
+        pollfd fds[] = {
+            {PQsocket(handle), POLLIN, 0},
+            {pipe_[0], POLLIN, 0},
+        };
+        if ((::poll(fds, 2, -1) < 0) && (errno != EINTR)) {
+            return;
+        }
+
+        if (fds[1].revents != 0) {
+            char buf[64];
+            while (0 < ::read(pipe_[0], buf, sizeof(buf))) {
+            }
+        }
+
+        if ((fds[0].revents != 0) && (PQconsumeInput(handle) != 1)) {
+            return;
+        }
+    }
+}
+
+bool Listener::sync(Connection& conn) {
+    std::vector<std::string> channels{};
+    std::vector<std::string> dropped{};
+    {
+        std::lock_guard guard{mtx_};
+        if (is_stopped_) {
+            return false;
+        }
+        channels.swap(pending_);
+        dropped.swap(dropped_);
+    }
+
+    for (auto const& channel : dropped) {
+        conn.execRaw("UNLISTEN " + conn.escId(channel));
+    }
+    for (auto const& channel : channels) {
+        if (!conn.execRaw("LISTEN " + conn.escId(channel)).isOk()) {
+            return false;
+        }
+
+        std::lock_guard guard{mtx_};
+        if (channels_.count(channel) != 0) {
+            listening_.insert(channel);
+        }
+    }
+    return conn.isOk();
+}
+
+void Listener::wake() {
+    signal_.notify_one();
+    char const byte = 0;
+    ::write(pipe_[1], &byte, 1);
+}
+
+void Listener::pause(int const failures) {
+    auto const       delay = std::chrono::milliseconds{100 << std::min(failures - 1, 7)};
+    std::unique_lock guard{mtx_};
+    signal_.wait_for(guard, delay, [this] {
+        return is_stopped_;
+    });
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,156 @@
+#include <postgres/internal/LogicalDecoder.h>
+
+#include <cstring>
+#include <utility>
+#include <postgres/internal/Bytes.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+class LogicalDecoder::Reader {
+public:
+    explicit Reader(std::string_view const data)
+        : data_{data} {
+    }
+
+    template <typename T>
+    T read() {
+        return orderBytes<T>(take(sizeof(T)));
+    }
+
+    std::string readString() {
+        auto const len = strnlen(data_.data(), data_.size());
+        _POSTGRES_CXX_ASSERT(RuntimeError, len < data_.size(), "unterminated string in message");
+        std::string res{take(len), len};
+        take(1);
+        return res;
+    }
+
+    std::string readBytes(size_t const len) {
+        return std::string{take(len), len};
+    }
+
+private:
+    char const* take(size_t const len) {
+        _POSTGRES_CXX_ASSERT(RuntimeError, len <= data_.size(), "truncated replication message");
+        auto const res = data_.data();
+        data_.remove_prefix(len);
+        return res;
+    }
+
+    std::string_view data_;
+};
+
+LogicalDecoder::LogicalDecoder() = default;
+
+LogicalDecoder::LogicalDecoder(LogicalDecoder&& other) noexcept = default;
+
+LogicalDecoder& LogicalDecoder::operator=(LogicalDecoder&& other) noexcept = default;
+
+LogicalDecoder::~LogicalDecoder() noexcept = default;
+
+std::optional<Change> LogicalDecoder::decode(std::string_view const msg, Lsn const lsn) {
+    Reader     in{msg};
+    auto const kind = in.read<char>();
+    switch (kind) {
+        case 'B': {
+            Change res{ChangeType::BEGIN, in.read<Lsn>()};
+            res.time_ = Time::EPOCH + std::chrono::microseconds{in.read<int64_t>()};
+            res.xid_  = xid_ = in.read<uint32_t>();
+            return res;
+        }
+        case 'C': {
+            in.read<int8_t>();
+            in.read<int64_t>();
+            Change res{ChangeType::COMMIT, in.read<Lsn>()};
+            res.time_ = Time::EPOCH + std::chrono::microseconds{in.read<int64_t>()};
+            res.xid_  = xid_;
+            return res;
+        }
+        case 'R': {
+            auto rel = std::make_shared<Relation>();
+            rel->id       = in.read<Oid>();
+            rel->schema   = in.readString();
+            rel->name     = in.readString();
+            rel->identity = in.read<char>();
+            rel->columns.resize(in.read<int16_t>());
+            for (auto& col : rel->columns) {
+                col.is_key   = (in.read<int8_t>() & 1) != 0;
+                col.name     = in.readString();
+                col.type     = in.read<Oid>();
+                col.modifier = in.read<int32_t>();
+            }
+
+            auto& known = relations_[rel->id];
+            known = std::move(rel);
+
+            Change res{ChangeType::RELATION, lsn};
+            res.xid_      = xid_;
+            res.relation_ = known;
+            return res;
+        }
+        case 'I': {
+            Change res{ChangeType::INSERT, lsn};
+            res.xid_      = xid_;
+            res.relation_ = relation(in.read<Oid>());
+            _POSTGRES_CXX_ASSERT(RuntimeError, in.read<char>() == 'N', "bad insert message");
+            res.tuple_ = readTuple(in, res.relation_);
+            return res;
+        }
+        case 'U': {
+            Change res{ChangeType::UPDATE, lsn};
+            res.xid_      = xid_;
+            res.relation_ = relation(in.read<Oid>());
+            auto part = in.read<char>();
+            if ((part == 'K') || (part == 'O')) {
+                res.old_ = readTuple(in, res.relation_);
+                part = in.read<char>();
+            }
+            _POSTGRES_CXX_ASSERT(RuntimeError, part == 'N', "bad update message");
+            res.tuple_ = readTuple(in, res.relation_);
+            return res;
+        }
+        case 'D': {
+            Change res{ChangeType::DELETE, lsn};
+            res.xid_      = xid_;
+            res.relation_ = relation(in.read<Oid>());
+            auto const part = in.read<char>();
+            _POSTGRES_CXX_ASSERT(RuntimeError, (part == 'K') || (part == 'O'), "bad delete message");
+            res.tuple_ = readTuple(in, res.relation_);
+            return res;
+        }
+        default: {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+Tuple LogicalDecoder::readTuple(Reader& in, std::shared_ptr<Relation const> const& rel) {
+    auto const size = in.read<int16_t>();
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         size == static_cast<int>(rel->columns.size()),
+                         "tuple does not match relation '" << rel->name << "'");
+
+    Tuple res{rel};
+    res.kinds_.reserve(size);
+    res.values_.reserve(size);
+    for (auto i = 0; i < size; ++i) {
+        auto const kind = in.read<char>();
+        res.kinds_.push_back(kind);
+        if ((kind == 't') || (kind == 'b')) {
+            res.values_.push_back(in.readBytes(in.read<uint32_t>()));
+        } else {
+            res.values_.emplace_back();
+        }
+    }
+    return res;
+}
+
+std::shared_ptr<Relation const> const& LogicalDecoder::relation(Oid const id) const {
+    auto const it = relations_.find(id);
+    _POSTGRES_CXX_ASSERT(RuntimeError, it != relations_.end(), "unknown relation " << id);
+    return it->second;
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,295 @@
+#include <postgres/internal/Multiplexer.h>
+
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+Multiplexer::Multiplexer(Factory const& connect, int const connections, EventBackend const backend)
+    : poller_{Poller::create(backend)} {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < connections, "bad connections: " << connections);
+
+    links_.reserve(connections);
+    for (auto i = 0; i < connections; ++i) {
+        auto       conn   = connect();
+        auto const handle = conn.native();
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             PQsetnonblocking(handle, 1) == 0,
+                             "fail to set nonblocking mode: " << conn.message());
+#ifdef LIBPQ_HAS_PIPELINING
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             PQenterPipelineMode(handle) == 1,
+                             "fail to enter pipeline mode: " << conn.message());
+#endif
+        auto const fd = PQsocket(handle);
+        links_.push_back(Link{std::move(conn), fd, {}, false, true});
+    }
+    for (auto& link : links_) {
+        fds_[link.fd] = &link;
+    }
+    alive_ = connections;
+
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC) == 0,
+                         "fail to create pipe: " << strerror(errno));
+    thread_ = std::thread([this] {
+        run();
+    });
+}
+
+Multiplexer::~Multiplexer() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+    }
+    wake();
+    thread_.join();
+    ::close(pipe_[0]);
+    ::close(pipe_[1]);
+}
+
+std::future<Result> Multiplexer::submit(Send send) {
+    std::promise<Result> promise{};
+    auto                 res = promise.get_future();
+    {
+        std::lock_guard guard{mtx_};
+        if (is_broken_) {
+            promise.set_exception(std::make_exception_ptr(
+                RuntimeError{"PostgreSQL client error: connection is lost"}));
+            return res;
+        }
+        queue_.push_back(Request{std::move(send), std::move(promise)});
+    }
+    wake();
+    return res;
+}
+
+bool Multiplexer::isOk() {
+    std::lock_guard guard{mtx_};
+    return !is_broken_;
+}
+
+EventBackend Multiplexer::backend() const {
+    return poller_->backend();
+}
+
+void Multiplexer::run() {
+    try {
+        serve();
+    } catch (std::exception const&) {
+        // Give up on all the connections.
+    }
+    fail();
+}
+
+// Statements already submitted are completed before the thread stops.
+void Multiplexer::serve() {
+    std::vector<Poller::Event> events{};
+    poller_->watch(pipe_[0], POLLIN);
+    while (0 < alive_) {
+        dispatch();
+
+        // Input may have been read while flushing, so results are taken before waiting.
+        auto is_idle = true;
+        for (auto& link : links_) {
+            if (link.is_lost) {
+                continue;
+            }
+            if ((!link.is_synced && !sync(link)) || !receive(link)) {
+                lose(link);
+                continue;
+            }
+
+            auto const flushed = PQflush(link.conn.native());
+            if (flushed < 0) {
+                lose(link);
+                continue;
+            }
+            poller_->watch(link.fd, static_cast<short>((flushed == 0) ? POLLIN : (POLLIN | POLLOUT)));
+            is_idle = is_idle && link.sent.empty();
+        }
+        {
+            std::lock_guard guard{mtx_};
+            if (is_stopped_ && is_idle && queue_.empty()) {
+                return;
+            }
+        }
+        if (alive_ == 0) {
+            return;
+        }
+
+        events.clear();
+        poller_->wait(events);
+        for (auto const& ev : events) {
+            if (ev.fd == pipe_[0]) {
+                char buf[64];
+                while (0 < ::read(pipe_[0], buf, sizeof(buf))) {
+                }
+                continue;
+            }
+
+            auto const it = fds_.find(ev.fd);
+            if ((it == fds_.end()) || it->second->is_lost) {
+                continue;
+            }
+            auto& link = *it->second;
+            if (((ev.events & (POLLIN | POLLERR | POLLHUP)) != 0)
+                && (PQconsumeInput(link.conn.native()) != 1)) {
+                lose(link);
+            }
+        }
+    }
+}
+
+void Multiplexer::dispatch() {
+    while (auto const link = pick()) {
+        Request req{};
+        {
+            std::lock_guard guard{mtx_};
+            if (queue_.empty()) {
+                return;
+            }
+            req = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // A statement rejected by libpq itself, a bad one for instance, fails alone.
+        auto const handle = link->conn.native();
+        if (req.send(handle) != 1) {
+            if (PQstatus(handle) == CONNECTION_OK) {
+                req.promise.set_exception(std::make_exception_ptr(
+                    RuntimeError{"PostgreSQL client error: " + link->conn.message()}));
+            } else {
+                link->sent.push_back(Pending{std::move(req.promise)});
+                lose(*link);
+            }
+            continue;
+        }
+
+        link->sent.push_back(Pending{std::move(req.promise)});
+        if (!sync(*link)) {
+            lose(*link);
+        }
+    }
+}
+
+// The statement stays in the pipeline even if the sync point is not sent,
+// so the link is given another try on the next round unless it is broken.
+bool Multiplexer::sync(Link& link) {
+#ifdef LIBPQ_HAS_PIPELINING
+    auto const handle = link.conn.native();
+    link.is_synced    = PQpipelineSync(handle) == 1;
+    return link.is_synced || (PQstatus(handle) == CONNECTION_OK);
+#else
+    static_cast<void>(link);
+    return true;
+#endif
+}
+
+Multiplexer::Link* Multiplexer::pick() {
+    Link* res = nullptr;
+    for (auto& link : links_) {
+        if (!link.is_lost && (!res || (link.sent.size() < res->sent.size()))) {
+            res = &link;
+        }
+    }
+#ifndef LIBPQ_HAS_PIPELINING
+    // Without pipelining the next statement waits for the previous one to complete.
+    if (res && !res->sent.empty()) {
+        return nullptr;
+    }
+#endif
+    return res;
+}
+
+bool Multiplexer::receive(Link& link) {
+    auto const handle = link.conn.native();
+    while (PQisBusy(handle) == 0) {
+        auto const res = PQgetResult(handle);
+
+        // The end of results of a statement, or nothing is expected at all.
+        if (res == nullptr) {
+            if (link.sent.empty() || !link.sent.front().res) {
+                break;
+            }
+            complete(link.sent.front());
+            link.sent.pop_front();
+            continue;
+        }
+
+#ifdef LIBPQ_HAS_PIPELINING
+        if (PQresultStatus(res) == PGRES_PIPELINE_SYNC) {
+            PQclear(res);
+            continue;
+        }
+#endif
+        if (link.sent.empty()) {
+            PQclear(res);
+            continue;
+        }
+        link.sent.front().res.reset(res);
+    }
+    return link.conn.isOk();
+}
+
+void Multiplexer::complete(Pending& item) {
+    try {
+        item.promise.set_value(Result{item.res.release()});
+    } catch (...) {
+        item.promise.set_exception(std::current_exception());
+    }
+}
+
+// Lost connections are not restored, statements in progress on them fail.
+void Multiplexer::lose(Link& link) {
+    link.is_lost = true;
+    poller_->watch(link.fd, 0);
+    // Callers seeing the failure of the last connection see it broken as well.
+    if (--alive_ == 0) {
+        std::lock_guard guard{mtx_};
+        is_broken_ = true;
+    }
+
+    auto const err = std::make_exception_ptr(
+        RuntimeError{"PostgreSQL client error: connection is lost: " + link.conn.message()});
+    for (auto& item : link.sent) {
+        item.promise.set_exception(err);
+    }
+    link.sent.clear();
+}
+
+// Once all the connections are lost, the statements submitted later fail as well.
+void Multiplexer::fail() {
+    std::deque<Request> queue{};
+    {
+        std::lock_guard guard{mtx_};
+        is_broken_ = true;
+        queue.swap(queue_);
+    }
+
+    auto const err = std::make_exception_ptr(
+        RuntimeError{"PostgreSQL client error: connection is lost"});
+    for (auto& link : links_) {
+        for (auto& item : link.sent) {
+            item.promise.set_exception(err);
+        }
+        link.sent.clear();
+    }
+    for (auto& req : queue) {
+        req.promise.set_exception(err);
+    }
+}
+
+void Multiplexer::wake() {
+    char const byte = 0;
+    ::write(pipe_[1], &byte, 1);
+}
+
+}  // namespace postgres::internal
@@ -0,0 +1,22 @@
+#include <postgres/internal/Poller.h>
+
+#include <postgres/internal/EpollPoller.h>
+#include <postgres/internal/UringPoller.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+std::unique_ptr<Poller> Poller::create(EventBackend const backend) {
+    if (backend == EventBackend::IO_URING) {
+        try {
+            return std::make_unique<UringPoller>();
+        } catch (RuntimeError const&) {
+            // Often disabled in containers, so fall back to epoll.
+        }
+    }
+    return std::make_unique<EpollPoller>();
+}
+
+Poller::~Poller() noexcept = default;
+
+}  // namespace postgres::internal
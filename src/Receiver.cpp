@@ -2,8 +2,8 @@
 
 namespace postgres {
 
-Receiver::Receiver(std::shared_ptr<PGconn> handle, int const is_ok)
-    : Consumer{std::move(handle), is_ok} {
+Receiver::Receiver(std::shared_ptr<PGconn> handle, int const is_ok, AbandonPolicy const abandon)
+    : Consumer{std::move(handle), is_ok, abandon} {
 }
 
 Receiver::Receiver(Receiver&& other) noexcept = default;
@@ -0,0 +1,228 @@
+#include <postgres/Replication.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <poll.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/LogicalDecoder.h>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+enum : char {
+    XLOG_DATA      = 'w',
+    KEEPALIVE      = 'k',
+    STANDBY_STATUS = 'r',
+};
+
+enum {
+    XLOG_DATA_HEADER = 1 + 8 + 8 + 8,
+    KEEPALIVE_SIZE   = 1 + 8 + 8 + 1,
+    STANDBY_SIZE     = 1 + 8 + 8 + 8 + 8 + 1,
+};
+
+std::string formatLsn(Lsn const lsn) {
+    char buf[32];
+    snprintf(buf,
+             sizeof(buf),
+             "%X/%X",
+             static_cast<uint32_t>(lsn >> 32),
+             static_cast<uint32_t>(lsn));
+    return buf;
+}
+
+Change::Change(ChangeType const type, Lsn const lsn)
+    : type_{type}, lsn_{lsn} {
+}
+
+Change::Change(Change const& other) = default;
+
+Change& Change::operator=(Change const& other) = default;
+
+Change::Change(Change&& other) noexcept = default;
+
+Change& Change::operator=(Change&& other) noexcept = default;
+
+Change::~Change() noexcept = default;
+
+ChangeType Change::type() const {
+    return type_;
+}
+
+Lsn Change::lsn() const {
+    return lsn_;
+}
+
+uint32_t Change::xid() const {
+    return xid_;
+}
+
+Time::Point Change::time() const {
+    return time_;
+}
+
+Relation const& Change::relation() const {
+    _POSTGRES_CXX_ASSERT(LogicError, relation_, "change has no relation");
+    return *relation_;
+}
+
+Tuple const& Change::tuple() const {
+    _POSTGRES_CXX_ASSERT(LogicError, tuple_, "change has no tuple");
+    return *tuple_;
+}
+
+std::optional<Tuple> const& Change::old() const {
+    return old_;
+}
+
+ReplicationStream::ReplicationStream(std::shared_ptr<PGconn> handle, PGresult* const res)
+    : handle_{std::move(handle)},
+      decoder_{std::make_unique<internal::LogicalDecoder>()},
+      interval_{std::chrono::seconds{10}},
+      last_feedback_{std::chrono::steady_clock::now()} {
+    auto const type = PQresultStatus(res);
+    PQclear(res);
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         type == PGRES_COPY_BOTH,
+                         "fail to start replication: " << PQerrorMessage(handle_.get()));
+}
+
+ReplicationStream::ReplicationStream(ReplicationStream&& other) noexcept = default;
+
+ReplicationStream& ReplicationStream::operator=(ReplicationStream&& other) noexcept = default;
+
+ReplicationStream::~ReplicationStream() noexcept {
+    if (!handle_) {
+        return;
+    }
+
+    auto const conn = handle_.get();
+    try {
+        feedback(true);
+    } catch (...) {
+        // Still end the stream.
+    }
+    if (PQputCopyEnd(conn, nullptr) != 1) {
+        return;
+    }
+    PQflush(conn);
+    while (auto const res = PQgetResult(conn)) {
+        PQclear(res);
+    }
+}
+
+std::optional<Change> ReplicationStream::next(Duration const timeout) {
+    auto const conn     = handle_.get();
+    auto const deadline = std::chrono::steady_clock::now() + timeout;
+    while (true) {
+        feedback(false);
+
+        char*      buf = nullptr;
+        auto const len = PQgetCopyData(conn, &buf, 1);
+        if (0 < len) {
+            std::unique_ptr<char, void (*)(void*)> const guard{buf, PQfreemem};
+            if (auto change = receive(buf, len)) {
+                return change;
+            }
+            continue;
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             len == 0,
+                             "replication stream is over: " << PQerrorMessage(conn));
+
+        auto const now = std::chrono::steady_clock::now();
+        if (deadline <= now) {
+            return std::nullopt;
+        }
+        wait(std::min<Duration>(deadline - now, last_feedback_ + interval_ - now));
+    }
+}
+
+void ReplicationStream::acknowledge(Lsn const lsn) {
+    acknowledged_ = std::max(acknowledged_, lsn);
+    received_     = std::max(received_, lsn);
+}
+
+void ReplicationStream::feedbackInterval(Duration const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < val.count(), "bad feedback interval: " << val.count());
+    interval_ = val;
+}
+
+Lsn ReplicationStream::received() const {
+    return received_;
+}
+
+Lsn ReplicationStream::acknowledged() const {
+    return acknowledged_;
+}
+
+std::optional<Change> ReplicationStream::receive(char const* const data, int const len) {
+    switch (data[0]) {
+        case XLOG_DATA: {
+            _POSTGRES_CXX_ASSERT(RuntimeError, XLOG_DATA_HEADER <= len, "truncated log data");
+            auto const lsn = internal::orderBytes<Lsn>(data + 1);
+            received_ = std::max(received_, lsn);
+            return decoder_->decode({data + XLOG_DATA_HEADER,
+                                     static_cast<size_t>(len - XLOG_DATA_HEADER)}, lsn);
+        }
+        case KEEPALIVE: {
+            _POSTGRES_CXX_ASSERT(RuntimeError, KEEPALIVE_SIZE <= len, "truncated keepalive");
+            if (data[KEEPALIVE_SIZE - 1] != 0) {
+                feedback(true);
+            }
+            break;
+        }
+        default: {
+            break;
+        }
+    }
+    return std::nullopt;
+}
+
+void ReplicationStream::feedback(bool const is_forced) {
+    auto const now = std::chrono::steady_clock::now();
+    if (!is_forced && (now < last_feedback_ + interval_)) {
+        return;
+    }
+
+    auto const micros = std::chrono::duration_cast<std::chrono::microseconds>(
+        Time::Clock::now() - Time::EPOCH).count();
+
+    char buf[STANDBY_SIZE];
+    auto pos = buf;
+    auto const put = [&pos](auto const val) {
+        auto const ordered = internal::orderBytes(val);
+        std::memcpy(pos, &ordered, sizeof(ordered));
+        pos += sizeof(ordered);
+    };
+    put(static_cast<char>(STANDBY_STATUS));
+    put(static_cast<int64_t>(received_));
+    put(static_cast<int64_t>(acknowledged_));
+    put(static_cast<int64_t>(acknowledged_));
+    put(static_cast<int64_t>(micros));
+    put(static_cast<char>(0));
+
+    auto const conn = handle_.get();
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (PQputCopyData(conn, buf, STANDBY_SIZE) == 1) && (PQflush(conn) == 0),
+                         "fail to send feedback: " << PQerrorMessage(conn));
+    last_feedback_ = now;
+}
+
+void ReplicationStream::wait(Duration const timeout) {
+    auto const conn   = handle_.get();
+    auto const millis = std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count();
+    pollfd     fd{PQsocket(conn), POLLIN, 0};
+    auto const res    = ::poll(&fd, 1, static_cast<int>(std::max<int64_t>(millis, 1)));
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         (0 <= res) || (errno == EINTR),
+                         "fail to wait for replication data: " << strerror(errno));
+    _POSTGRES_CXX_ASSERT(RuntimeError,
+                         PQconsumeInput(conn) == 1,
+                         "fail to receive replication data: " << PQerrorMessage(conn));
+}
+
+}  // namespace postgres
@@ -0,0 +1,81 @@
+#include <postgres/RetryPolicy.h>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <postgres/internal/Backoff.h>
+#include <postgres/Error.h>
+
+namespace postgres {
+
+RetryPolicy::RetryPolicy()
+    : attempts_{5},
+      min_backoff_{std::chrono::milliseconds{10}},
+      max_backoff_{std::chrono::seconds{1}},
+      isolation_{IsolationLevel::DEFAULT},
+      is_read_only_{false},
+      states_{"40001", "40P01"} {
+}
+
+RetryPolicy::RetryPolicy(RetryPolicy const& other) = default;
+
+RetryPolicy& RetryPolicy::operator=(RetryPolicy const& other) = default;
+
+RetryPolicy::RetryPolicy(RetryPolicy&& other) noexcept = default;
+
+RetryPolicy& RetryPolicy::operator=(RetryPolicy&& other) noexcept = default;
+
+RetryPolicy::~RetryPolicy() noexcept = default;
+
+RetryPolicy& RetryPolicy::attempts(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 1 <= val, "bad attempts: " << val);
+    attempts_ = val;
+    return *this;
+}
+
+RetryPolicy& RetryPolicy::backoff(Duration const min, Duration const max) {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         (0 <= min.count()) && (min <= max),
+                         "bad backoff: " << min.count() << ", " << max.count());
+    min_backoff_ = min;
+    max_backoff_ = max;
+    return *this;
+}
+
+RetryPolicy& RetryPolicy::isolation(IsolationLevel const val) {
+    isolation_ = val;
+    return *this;
+}
+
+RetryPolicy& RetryPolicy::readOnly(bool const val) {
+    is_read_only_ = val;
+    return *this;
+}
+
+RetryPolicy& RetryPolicy::retryOn(std::string state) {
+    states_.push_back(std::move(state));
+    return *this;
+}
+
+int RetryPolicy::attempts() const {
+    return attempts_;
+}
+
+IsolationLevel RetryPolicy::isolation() const {
+    return isolation_;
+}
+
+bool RetryPolicy::isReadOnly() const {
+    return is_read_only_;
+}
+
+bool RetryPolicy::isRetryable(std::string const& state) const {
+    return std::find(states_.begin(), states_.end(), state) != states_.end();
+}
+
+RetryPolicy::Duration RetryPolicy::delay(int const failures) const {
+    thread_local std::minstd_rand rnd{std::random_device{}()};
+    return std::chrono::duration_cast<Duration>(internal::backoff(min_backoff_, max_backoff_, failures, rnd));
+}
+
+}  // namespace postgres
@@ -3,6 +3,20 @@
 
 namespace postgres {
 
+static char fold(char const c) {
+    return (('A' <= c) && (c <= 'Z')) ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Folds the name to lower case the way PQfnumber() does, leaving quoted names to it.
+static bool isNamed(char const* col, char const* name) {
+    for (; *name != '\0'; ++col, ++name) {
+        if ((*name == '"') || (*col != fold(*name))) {
+            return false;
+        }
+    }
+    return *col == '\0';
+}
+
 Row::Row(PGresult& res, int const row_idx)
     : res_{&res}, row_idx_{row_idx}, col_idx_{0} {
 }
@@ -34,6 +48,16 @@ Field Row::operator[](int const col_idx) const {
     return Field{*res_, row_idx_, col_idx};
 }
 
+int Row::find(char const* const name) {
+    auto col_idx = hint_;
+    if ((size() <= col_idx) || !isNamed(PQfname(res_, col_idx), name)) {
+        col_idx = PQfnumber(res_, name);
+        _POSTGRES_CXX_ASSERT(LogicError, (0 <= col_idx), "column '" << name << "' does not exist");
+    }
+    hint_ = col_idx + 1;
+    return col_idx;
+}
+
 int Row::size() const {
     return PQnfields(res_);
 }
@@ -0,0 +1,142 @@
+#include <postgres/SharedConnection.h>
+
+#include <utility>
+#include <postgres/internal/Multiplexer.h>
+#include <postgres/Command.h>
+#include <postgres/Config.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+
+namespace postgres {
+
+enum {
+    RESULT_FORMAT = 1,
+};
+
+SharedConnection::SharedConnection()
+    : SharedConnection{Config::build()} {
+}
+
+SharedConnection::SharedConnection(Config const& cfg)
+    : SharedConnection{[&cfg] {
+        return Connection{cfg};
+    }, 1, EventBackend::EPOLL} {
+}
+
+SharedConnection::SharedConnection(std::string const& uri)
+    : SharedConnection{[&uri] {
+        return Connection{uri};
+    }, 1, EventBackend::EPOLL} {
+}
+
+SharedConnection::SharedConnection(std::function<Connection()> const& connect,
+                                   int const connections,
+                                   EventBackend const backend)
+    : mux_{std::make_unique<internal::Multiplexer>(connect, connections, backend)} {
+}
+
+SharedConnection::SharedConnection(SharedConnection&& other) noexcept = default;
+
+SharedConnection& SharedConnection::operator=(SharedConnection&& other) noexcept = default;
+
+SharedConnection::~SharedConnection() noexcept = default;
+
+std::future<Result> SharedConnection::exec(PrepareData prep) {
+    return mux_->submit([prep = std::move(prep)](PGconn* const conn) {
+        return PQsendPrepare(conn,
+                             prep.name.data(),
+                             prep.statement.data(),
+                             static_cast<int>(prep.types.size()),
+                             prep.types.data());
+    });
+}
+
+std::future<Result> SharedConnection::exec(Command cmd) {
+    return mux_->submit([cmd = std::make_shared<Command>(std::move(cmd))](PGconn* const conn) {
+        return PQsendQueryParams(conn,
+                                 cmd->statement(),
+                                 cmd->count(),
+                                 cmd->types(),
+                                 cmd->values(),
+                                 cmd->lengths(),
+                                 cmd->formats(),
+                                 RESULT_FORMAT);
+    });
+}
+
+std::future<Result> SharedConnection::exec(PreparedCommand cmd) {
+    return mux_->submit([cmd = std::make_shared<PreparedCommand>(std::move(cmd))](PGconn* const conn) {
+        return PQsendQueryPrepared(conn,
+                                   cmd->statement(),
+                                   cmd->count(),
+                                   cmd->values(),
+                                   cmd->lengths(),
+                                   cmd->formats(),
+                                   RESULT_FORMAT);
+    });
+}
+
+bool SharedConnection::isOk() {
+    return mux_->isOk();
+}
+
+EventBackend SharedConnection::backend() const {
+    return mux_->backend();
+}
+
+SharedConnection::Builder::Builder()
+    : connect_{[] {
+        return Connection{};
+    }} {
+}
+
+SharedConnection::Builder::Builder(Builder&& other) noexcept = default;
+
+SharedConnection::Builder& SharedConnection::Builder::operator=(Builder&& other) noexcept = default;
+
+SharedConnection::Builder::~Builder() noexcept = default;
+
+SharedConnection::Builder& SharedConnection::Builder::config(Config cfg) {
+    connect_ = [cfg = std::make_shared<Config const>(std::move(cfg))] {
+        return Connection{*cfg};
+    };
+    return *this;
+}
+
+SharedConnection::Builder& SharedConnection::Builder::uri(std::string uri) {
+    connect_ = [uri = std::move(uri)] {
+        return Connection{uri};
+    };
+    return *this;
+}
+
+SharedConnection::Builder& SharedConnection::Builder::connections(int const val) {
+    _POSTGRES_CXX_ASSERT(LogicError, 0 < val, "bad connections: " << val);
+    connections_ = val;
+    return *this;
+}
+
+SharedConnection::Builder& SharedConnection::Builder::backend(EventBackend const val) {
+    backend_ = val;
+    return *this;
+}
+
+SharedConnection::Builder& SharedConnection::Builder::prepare(PrepareData prep) {
+    preps_.push_back(std::move(prep));
+    return *this;
+}
+
+SharedConnection SharedConnection::Builder::build() {
+    auto const connect = [connect = std::move(connect_), preps = std::move(preps_)] {
+        auto conn = connect();
+        for (auto const& prep : preps) {
+            conn.exec(prep);
+        }
+        return conn;
+    };
+    return SharedConnection{connect, connections_, backend_};
+}
+
+}  // namespace postgres
@@ -28,9 +28,14 @@ void Status::check() const {
         _POSTGRES_CXX_FAIL(LogicError, "rows stream is over");
     }
 
-    _POSTGRES_CXX_ASSERT(RuntimeError,
-                         isOk(),
-                         "fail to execute operation: " << describe() << ": " << message());
+    if (isOk()) {
+        return;
+    }
+
+    std::stringstream msg{};
+    msg << "PostgreSQL client error: fail to execute operation: " << describe() << ": " << message();
+    auto const state = PQresultErrorField(native(), PG_DIAG_SQLSTATE);
+    throw SqlError{msg.str(), (state == nullptr) ? "" : state};
 }
 
 bool Status::isOk() const {
@@ -38,6 +43,9 @@ bool Status::isOk() const {
         case PGRES_COMMAND_OK:
         case PGRES_TUPLES_OK:
         case PGRES_SINGLE_TUPLE:
+#ifdef LIBPQ_HAS_CHUNK_MODE
+        case PGRES_TUPLES_CHUNK:
+#endif
         case PGRES_NONFATAL_ERROR: {
             return true;
         }
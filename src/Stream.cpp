@@ -0,0 +1,110 @@
+#include <postgres/Stream.h>
+
+#include <utility>
+
+namespace postgres {
+
+Stream::Stream(std::function<Result()> fetch, std::function<void()> close)
+    : fetch_{std::move(fetch)}, close_{std::move(close)} {
+}
+
+Stream::Stream(Stream&& other) noexcept
+    : fetch_{std::move(other.fetch_)},
+      close_{std::exchange(other.close_, nullptr)},
+      chunk_{std::move(other.chunk_)},
+      idx_{other.idx_} {
+}
+
+Stream& Stream::operator=(Stream&& other) noexcept {
+    if (this != &other) {
+        Stream tmp{std::move(*this)};
+        fetch_ = std::move(other.fetch_);
+        close_ = std::exchange(other.close_, nullptr);
+        chunk_ = std::move(other.chunk_);
+        idx_   = other.idx_;
+    }
+    return *this;
+}
+
+Stream::~Stream() noexcept {
+    if (!close_) {
+        return;
+    }
+    try {
+        close_();
+    } catch (...) {
+        // The connection is probably broken anyway.
+    }
+}
+
+Stream::iterator Stream::begin() {
+    return iterator{chunk().isEmpty() ? nullptr : this};
+}
+
+Stream::iterator Stream::end() {
+    return iterator{nullptr};
+}
+
+Result const& Stream::chunk() {
+    if (!chunk_) {
+        chunk_.emplace(fetch_());
+        idx_ = 0;
+    }
+    return *chunk_;
+}
+
+bool Stream::next() {
+    if (chunk().isEmpty()) {
+        return false;
+    }
+    if (++idx_ < chunk_->size()) {
+        return true;
+    }
+    chunk_.reset();
+    return !chunk().isEmpty();
+}
+
+Result Stream::take() {
+    chunk();
+    auto res = std::move(*chunk_);
+    chunk_.reset();
+    return res;
+}
+
+Stream::iterator::iterator(Stream* const stream)
+    : stream_{stream} {
+}
+
+Stream::iterator::iterator(iterator const& other) = default;
+
+Stream::iterator& Stream::iterator::operator=(iterator const& other) = default;
+
+Stream::iterator::iterator(iterator&& other) noexcept = default;
+
+Stream::iterator& Stream::iterator::operator=(iterator&& other) noexcept = default;
+
+Stream::iterator::~iterator() noexcept = default;
+
+bool Stream::iterator::operator==(iterator const& other) const {
+    return stream_ == other.stream_;
+}
+
+bool Stream::iterator::operator!=(iterator const& other) const {
+    return !(*this == other);
+}
+
+void Stream::iterator::operator++() {
+    if (!stream_->next()) {
+        stream_ = nullptr;
+    }
+}
+
+Row Stream::iterator::operator->() const {
+    return this->operator*();
+}
+
+Row Stream::iterator::operator*() const {
+    return (*stream_->chunk_)[stream_->idx_];
+}
+
+}  // namespace postgres
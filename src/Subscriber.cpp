@@ -0,0 +1,136 @@
+#include <postgres/Subscriber.h>
+
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <postgres/internal/Listener.h>
+#include <postgres/Config.h>
+#include <postgres/Connection.h>
+
+namespace postgres {
+
+struct Subscriber::Handlers {
+    void dispatch(Notification const& note) {
+        std::vector<Callback> callbacks{};
+        {
+            std::lock_guard guard{mtx};
+            auto const      it = channels.find(note.channel);
+            if (it == channels.end()) {
+                return;
+            }
+            callbacks = it->second;
+        }
+
+        for (auto& callback : callbacks) {
+            try {
+                if (executor) {
+                    executor([callback = std::move(callback), note] {
+                        callback(note);
+                    });
+                } else {
+                    callback(note);
+                }
+            } catch (...) {
+                // Keep listening.
+            }
+        }
+    }
+
+    void reset() {
+        if (!on_reset) {
+            return;
+        }
+        try {
+            if (executor) {
+                executor(on_reset);
+            } else {
+                on_reset();
+            }
+        } catch (...) {
+            // Keep listening.
+        }
+    }
+
+    std::map<std::string, std::vector<Callback>> channels;
+    Executor                                     executor;
+    std::function<void()>                        on_reset;
+    std::mutex                                   mtx;
+};
+
+Subscriber::Subscriber(std::function<Connection()> connect, std::shared_ptr<Handlers> handlers)
+    : handlers_{std::move(handlers)} {
+    listener_ = std::make_unique<internal::Listener>(
+        std::move(connect),
+        [handlers = handlers_](Notification note) {
+            handlers->dispatch(note);
+        },
+        [handlers = handlers_] {
+            handlers->reset();
+        });
+}
+
+Subscriber::Subscriber(Subscriber&& other) noexcept = default;
+
+Subscriber& Subscriber::operator=(Subscriber&& other) noexcept = default;
+
+Subscriber::~Subscriber() noexcept = default;
+
+void Subscriber::subscribe(std::string const& channel, Callback callback) {
+    {
+        std::lock_guard guard{handlers_->mtx};
+        handlers_->channels[channel].push_back(std::move(callback));
+    }
+    listener_->listen(channel);
+}
+
+void Subscriber::unsubscribe(std::string const& channel) {
+    {
+        std::lock_guard guard{handlers_->mtx};
+        handlers_->channels.erase(channel);
+    }
+    listener_->unlisten(channel);
+}
+
+Subscriber::Builder::Builder()
+    : connect_{[] {
+        return Connection{};
+    }},
+      handlers_{std::make_shared<Handlers>()} {
+}
+
+Subscriber::Builder::Builder(Builder&& other) noexcept = default;
+
+Subscriber::Builder& Subscriber::Builder::operator=(Builder&& other) noexcept = default;
+
+Subscriber::Builder::~Builder() noexcept = default;
+
+Subscriber::Builder& Subscriber::Builder::config(Config cfg) {
+    connect_ = [cfg = std::make_shared<Config const>(std::move(cfg))] {
+        return Connection{*cfg};
+    };
+    return *this;
+}
+
+Subscriber::Builder& Subscriber::Builder::uri(std::string uri) {
+    connect_ = [uri = std::move(uri)] {
+        return Connection{uri};
+    };
+    return *this;
+}
+
+Subscriber::Builder& Subscriber::Builder::executor(Executor val) {
+    handlers_->executor = std::move(val);
+    return *this;
+}
+
+Subscriber::Builder& Subscriber::Builder::onReset(std::function<void()> val) {
+    handlers_->on_reset = std::move(val);
+    return *this;
+}
+
+Subscriber Subscriber::Builder::build() {
+    return Subscriber{std::move(connect_), std::move(handlers_)};
+}
+
+}  // namespace postgres
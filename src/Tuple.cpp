@@ -0,0 +1,101 @@
+#include <postgres/Tuple.h>
+
+#include <utility>
+
+namespace postgres {
+
+enum : char {
+    NULL_VALUE      = 'n',
+    UNCHANGED_VALUE = 'u',
+};
+
+int Relation::find(std::string_view const col_name) const {
+    for (auto i = 0u; i < columns.size(); ++i) {
+        if (columns[i].name == col_name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+Tuple::Tuple(std::shared_ptr<Relation const> rel)
+    : relation_{std::move(rel)} {
+}
+
+Tuple::Tuple(Tuple const& other) = default;
+
+Tuple& Tuple::operator=(Tuple const& other) = default;
+
+Tuple::Tuple(Tuple&& other) noexcept = default;
+
+Tuple& Tuple::operator=(Tuple&& other) noexcept = default;
+
+Tuple::~Tuple() noexcept = default;
+
+bool Tuple::isNull(int const idx) const {
+    return kinds_.at(idx) == NULL_VALUE;
+}
+
+bool Tuple::isUnchanged(int const idx) const {
+    return kinds_.at(idx) == UNCHANGED_VALUE;
+}
+
+std::string_view Tuple::value(int const idx) const {
+    return values_.at(idx);
+}
+
+int Tuple::size() const {
+    return static_cast<int>(values_.size());
+}
+
+Relation const& Tuple::relation() const {
+    return *relation_;
+}
+
+void Tuple::read(int const idx, Time& out) const {
+    Time::Point pnt{};
+    read(idx, pnt);
+    out = Time{pnt};
+}
+
+void Tuple::read(int const idx, Time::Point& out) const {
+    // 2017-08-25 13:03:35.123457
+    // 2017-08-25 13:03:35.123457+03
+    // 2017-08-25 13:03:35-05:30
+    auto const val  = text(idx);
+    auto const zone = val.find_first_of("+-", 19);
+    out = Time{std::string{val.substr(0, zone)}}.point();
+    if (zone == std::string_view::npos) {
+        return;
+    }
+
+    auto const sign    = (val[zone] == '-') ? -1 : 1;
+    auto       hours   = 0;
+    auto       minutes = 0;
+    auto const end     = val.data() + val.size();
+    auto       res     = std::from_chars(val.data() + zone + 1, end, hours);
+    if ((res.ec == std::errc{}) && (res.ptr != end) && (*res.ptr == ':')) {
+        res = std::from_chars(res.ptr + 1, end, minutes);
+    }
+    _POSTGRES_CXX_ASSERT(LogicError, res.ec == std::errc{}, "bad time zone in '" << val << "'");
+    out -= sign * (std::chrono::hours{hours} + std::chrono::minutes{minutes});
+}
+
+void Tuple::read(int const idx, std::string& out) const {
+    out = std::string{text(idx)};
+}
+
+void Tuple::read(int const idx, std::string_view& out) const {
+    out = text(idx);
+}
+
+std::string_view Tuple::text(int const idx) const {
+    _POSTGRES_CXX_ASSERT(LogicError,
+                         !isNull(idx),
+                         "cannot store NULL value of field '"
+                             << relation_->columns[idx].name
+                             << "' into variable of non-optional type");
+    return value(idx);
+}
+
+}  // namespace postgres
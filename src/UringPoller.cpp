@@ -0,0 +1,208 @@
+#include <postgres/internal/UringPoller.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+enum : unsigned {
+    ENTRIES = 256,
+};
+
+// Completions of removals are of no interest.
+static constexpr uint64_t REMOVAL = ~uint64_t{0};
+
+static uint64_t makeData(int const fd, uint32_t const gen) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(fd)) << 32) | gen;
+}
+
+static void* mapRing(int const fd, size_t const size, off_t const offset) {
+    auto const ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return (ptr == MAP_FAILED) ? nullptr : ptr;
+}
+
+template <typename T>
+static T* at(void* const ring, uint32_t const offset) {
+    return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+UringPoller::UringPoller() {
+    io_uring_params params{};
+    fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, ENTRIES, &params));
+    _POSTGRES_CXX_ASSERT(RuntimeError, 0 <= fd_, "fail to set up io_uring: " << strerror(errno));
+
+    sq_size_   = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_   = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+
+    sq_ring_ = mapRing(fd_, sq_size_, IORING_OFF_SQ_RING);
+    cq_ring_ = (params.features & IORING_FEAT_SINGLE_MMAP)
+               ? sq_ring_
+               : mapRing(fd_, cq_size_, IORING_OFF_CQ_RING);
+    sqes_    = static_cast<io_uring_sqe*>(mapRing(fd_, sqes_size_, IORING_OFF_SQES));
+    if (!sq_ring_ || !cq_ring_ || !sqes_) {
+        auto const err = errno;
+        release();
+        _POSTGRES_CXX_FAIL(RuntimeError, "fail to map io_uring: " << strerror(err));
+    }
+
+    sq_head_    = at<unsigned>(sq_ring_, params.sq_off.head);
+    sq_tail_    = at<unsigned>(sq_ring_, params.sq_off.tail);
+    sq_array_   = at<unsigned>(sq_ring_, params.sq_off.array);
+    sq_mask_    = *at<unsigned>(sq_ring_, params.sq_off.ring_mask);
+    sq_entries_ = params.sq_entries;
+    cq_head_    = at<unsigned>(cq_ring_, params.cq_off.head);
+    cq_tail_    = at<unsigned>(cq_ring_, params.cq_off.tail);
+    cqes_       = at<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+    cq_mask_    = *at<unsigned>(cq_ring_, params.cq_off.ring_mask);
+}
+
+UringPoller::~UringPoller() noexcept {
+    release();
+}
+
+void UringPoller::release() {
+    if (sqes_) {
+        ::munmap(sqes_, sqes_size_);
+        sqes_ = nullptr;
+    }
+    if (cq_ring_ && (cq_ring_ != sq_ring_)) {
+        ::munmap(cq_ring_, cq_size_);
+    }
+    cq_ring_ = nullptr;
+    if (sq_ring_) {
+        ::munmap(sq_ring_, sq_size_);
+        sq_ring_ = nullptr;
+    }
+    if (0 <= fd_) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+EventBackend UringPoller::backend() const {
+    return EventBackend::IO_URING;
+}
+
+void UringPoller::watch(int const fd, short const events) {
+    if (events != 0) {
+        entries_[fd].wanted = events;
+        return;
+    }
+
+    auto const it = entries_.find(fd);
+    if (it == entries_.end()) {
+        return;
+    }
+    if (it->second.armed != 0) {
+        push(IORING_OP_POLL_REMOVE, -1, 0, makeData(fd, it->second.gen), REMOVAL);
+    }
+    entries_.erase(it);
+}
+
+void UringPoller::wait(std::vector<Event>& out) {
+    auto const size = out.size();
+    while (out.size() == size) {
+        arm();
+        enter(1);
+        reap(out);
+    }
+}
+
+// Polls whose events have changed are replaced, the stale completions are told by generation.
+// Generations are never reused, even by a descriptor dropped and watched again.
+void UringPoller::arm() {
+    for (auto& [fd, entry] : entries_) {
+        if (entry.armed == entry.wanted) {
+            continue;
+        }
+        if (entry.armed != 0) {
+            push(IORING_OP_POLL_REMOVE, -1, 0, makeData(fd, entry.gen), REMOVAL);
+        }
+        entry.gen = ++gen_;
+        push(IORING_OP_POLL_ADD, fd, static_cast<uint16_t>(entry.wanted), 0, makeData(fd, entry.gen));
+        entry.armed = entry.wanted;
+    }
+}
+
+void UringPoller::push(uint8_t const opcode,
+                       int const fd,
+                       uint32_t const events,
+                       uint64_t const addr,
+                       uint64_t const data) {
+    auto const tail = *sq_tail_;
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == sq_entries_) {
+        enter(0);
+    }
+
+    auto const idx = tail & sq_mask_;
+    auto&      sqe = sqes_[idx];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode        = opcode;
+    sqe.fd            = fd;
+    sqe.poll32_events = events;
+    sqe.addr          = addr;
+    sqe.user_data     = data;
+    sq_array_[idx]    = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+}
+
+// Submits everything pushed so far, waiting for completions in the same call.
+void UringPoller::enter(unsigned const min_complete) {
+    while (true) {
+        auto const pending = *sq_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        auto const res     = ::syscall(__NR_io_uring_enter,
+                                       fd_,
+                                       pending,
+                                       min_complete,
+                                       (0 < min_complete) ? IORING_ENTER_GETEVENTS : 0u,
+                                       nullptr,
+                                       0);
+        if (0 <= res) {
+            return;
+        }
+        _POSTGRES_CXX_ASSERT(RuntimeError,
+                             (errno == EINTR) || (errno == EAGAIN) || (errno == EBUSY),
+                             "fail to enter io_uring: " << strerror(errno));
+        if (errno != EINTR) {
+            // Completion queue is full, make room for more.
+            return;
+        }
+    }
+}
+
+void UringPoller::reap(std::vector<Event>& out) {
+    auto       head = *cq_head_;
+    auto const tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head) {
+        auto const& cqe = cqes_[head & cq_mask_];
+        if (cqe.user_data == REMOVAL) {
+            continue;
+        }
+
+        auto const fd = static_cast<int>(cqe.user_data >> 32);
+        auto const it = entries_.find(fd);
+        if ((it == entries_.end()) || (it->second.gen != static_cast<uint32_t>(cqe.user_data))) {
+            continue;
+        }
+        it->second.armed = 0;
+        if (cqe.res == -ECANCELED) {
+            continue;
+        }
+        auto const events = (cqe.res < 0) ? POLLERR : (cqe.res & (POLLIN | POLLOUT | POLLERR | POLLHUP));
+        out.push_back(Event{fd, static_cast<short>(events)});
+    }
+    __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
+
+}  // namespace postgres::internal
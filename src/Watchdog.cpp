@@ -0,0 +1,101 @@
+#include <postgres/internal/Watchdog.h>
+
+#include <utility>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+struct Watchdog::Entry {
+    std::unique_ptr<PGcancel, void (*)(PGcancel*)> cncl;
+    bool                                           is_fired;
+    bool                                           is_firing;
+};
+
+Watchdog::Watchdog() = default;
+
+Watchdog::~Watchdog() noexcept {
+    {
+        std::lock_guard guard{mtx_};
+        is_stopped_ = true;
+        signal_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+Watchdog::Watch Watchdog::watch(Connection const& conn, Clock::time_point const deadline) {
+    auto entry = std::make_shared<Entry>(Entry{{PQgetCancel(conn.native()), PQfreeCancel}, false, false});
+    _POSTGRES_CXX_ASSERT(RuntimeError, entry->cncl, "fail to create cancel request");
+
+    std::lock_guard guard{mtx_};
+    if (!thread_.joinable()) {
+        thread_ = std::thread([this] {
+            run();
+        });
+    }
+
+    auto const it = entries_.emplace(deadline, std::move(entry));
+    if (it == entries_.begin()) {
+        signal_.notify_one();
+    }
+    return Watch{*this, it};
+}
+
+void Watchdog::run() {
+    std::unique_lock guard{mtx_};
+    while (!is_stopped_) {
+        if (entries_.empty()) {
+            signal_.wait(guard);
+            continue;
+        }
+
+        auto const it = entries_.begin();
+        if (Clock::now() < it->first) {
+            signal_.wait_until(guard, it->first);
+            continue;
+        }
+
+        // The blocking cancel runs unlocked, while the release of the watch waits for it,
+        // so the request never hits a command sent after the watched one is over.
+        auto const entry = std::move(it->second);
+        entry->is_fired  = true;
+        entry->is_firing = true;
+        entries_.erase(it);
+        guard.unlock();
+
+        char err[256];
+        PQcancel(entry->cncl.get(), err, sizeof(err));
+
+        guard.lock();
+        entry->is_firing = false;
+        fired_.notify_all();
+    }
+}
+
+void Watchdog::release(Watch const& watch) {
+    std::unique_lock guard{mtx_};
+    fired_.wait(guard, [&watch] {
+        return !watch.entry_->is_firing;
+    });
+    // Fired entries are already erased.
+    if (!watch.entry_->is_fired) {
+        entries_.erase(watch.it_);
+    }
+}
+
+Watchdog::Watch::Watch(Watchdog& dog, Entries::iterator const it)
+    : dog_{dog}, it_{it}, entry_{it->second} {
+}
+
+Watchdog::Watch::~Watch() noexcept {
+    dog_.release(*this);
+}
+
+bool Watchdog::Watch::isFired() const {
+    std::lock_guard guard{dog_.mtx_};
+    return entry_->is_fired;
+}
+
+}  // namespace postgres::internal
@@ -4,6 +4,7 @@
 #include <postgres/internal/IChannel.h>
 #include <postgres/Connection.h>
 #include <postgres/Context.h>
+#include <postgres/Error.h>
 
 namespace postgres::internal {
 
@@ -31,21 +32,61 @@ void Worker::run() {
     if (thread_.joinable()) {
         thread_.join();
     }
-    thread_ = std::thread([this, conn = ctx_->connect()]() mutable {
+    slot_.is_joined = false;
+    thread_ = std::thread([this] {
+        auto conn = connect();
+        if (!conn) {
+            return;
+        }
+
+        auto born = Job::Clock::now();
         while (true) {
             chan_->receive(slot_);
             auto const job = std::move(slot_.job);
             if (!job) {
                 break;
             }
+            if (job.isExpired(Job::Clock::now())) {
+                job.expire();
+                continue;
+            }
 
-            job(conn);
-            if (!conn.isOk()) {
-                break;
+            job(*conn);
+            if (conn->isOk() && !isWornOut(born)) {
+                continue;
             }
+
+            // Broken connections are restored and worn out ones replaced,
+            // keeping the worker in the pool.
+            conn.reset();
+            conn = connect();
+            if (!conn) {
+                return;
+            }
+            born = Job::Clock::now();
         }
         chan_->recycle(*this);
     });
 }
 
+bool Worker::isWornOut(Job::Clock::time_point const born) const {
+    auto const lim = ctx_->maxLifetime();
+    return (0 < lim.count()) && (born + lim <= Job::Clock::now());
+}
+
+// Connecting in the worker thread lets the queued jobs wait for it instead of the submitter.
+std::optional<Connection> Worker::connect() {
+    while (true) {
+        try {
+            return ctx_->connect();
+        } catch (RuntimeError const&) {
+            auto const delay = chan_->fail(*this, slot_, std::current_exception());
+            if (delay.count() == 0) {
+                return std::nullopt;
+            }
+            std::this_thread::sleep_for(delay);
+        }
+    }
+}
+
 }  // namespace postgres::internal
@@ -0,0 +1,55 @@
+#include <stdexcept>
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/internal/BoundedQueue.h>
+#include <postgres/Error.h>
+
+namespace postgres::internal {
+
+TEST(BoundedQueueTest, Bad) {
+    ASSERT_THROW(BoundedQueue<int>{0}, LogicError);
+}
+
+TEST(BoundedQueueTest, Order) {
+    BoundedQueue<int> queue{2};
+    std::thread       producer{[&queue] {
+        for (auto i = 0; i < 100; ++i) {
+            queue.push(i);
+        }
+        queue.close();
+    }};
+
+    auto n = 0;
+    while (auto const item = queue.pop()) {
+        ASSERT_EQ(n++, *item);
+    }
+    producer.join();
+    ASSERT_EQ(100, n);
+}
+
+TEST(BoundedQueueTest, Abandon) {
+    BoundedQueue<int> queue{1};
+    ASSERT_TRUE(queue.push(1));
+    std::thread consumer{[&queue] {
+        queue.close();
+    }};
+    ASSERT_FALSE(queue.push(2));
+    consumer.join();
+}
+
+TEST(BoundedQueueTest, Fail) {
+    BoundedQueue<int> queue{1};
+    queue.push(1);
+    queue.fail(std::make_exception_ptr(std::runtime_error{"fail"}));
+    ASSERT_EQ(1, queue.pop());
+    ASSERT_THROW(queue.pop(), std::runtime_error);
+}
+
+TEST(BoundedQueueTest, FailClosed) {
+    BoundedQueue<int> queue{1};
+    queue.close();
+    queue.fail(std::make_exception_ptr(std::runtime_error{"fail"}));
+    ASSERT_FALSE(queue.pop());
+}
+
+}  // namespace postgres::internal
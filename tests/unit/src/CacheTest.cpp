@@ -0,0 +1,86 @@
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/Cache.h>
+#include <postgres/Error.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+TEST(CacheTest, Default) {
+    auto const cache = Cache::Builder{}.share();
+    ASSERT_LT(0, cache->timeToLive().count());
+    ASSERT_LT(0, cache->maxSize());
+    ASSERT_EQ(0, cache->size());
+}
+
+TEST(CacheTest, Bad) {
+    ASSERT_THROW(Cache::Builder{}.timeToLive(0s), LogicError);
+    ASSERT_THROW(Cache::Builder{}.timeToLive(-1s), LogicError);
+    ASSERT_THROW(Cache::Builder{}.maxSize(0), LogicError);
+}
+
+TEST(CacheTest, Put) {
+    auto const cache = Cache::Builder{}.share();
+    ASSERT_FALSE(cache->get("k"));
+    cache->put("k", "chan", std::make_shared<int const>(1));
+    auto const val = cache->get("k");
+    ASSERT_TRUE(val);
+    ASSERT_EQ(1, *std::static_pointer_cast<int const>(val));
+
+    cache->put("k", "chan", std::make_shared<int const>(2));
+    ASSERT_EQ(1, cache->size());
+    ASSERT_EQ(2, *std::static_pointer_cast<int const>(cache->get("k")));
+
+    cache->erase("k");
+    ASSERT_FALSE(cache->get("k"));
+    ASSERT_EQ(0, cache->size());
+}
+
+TEST(CacheTest, Expire) {
+    auto const cache = Cache::Builder{}.timeToLive(10ms).share();
+    cache->put("k", "chan", std::make_shared<int const>(1));
+    ASSERT_TRUE(cache->get("k"));
+    std::this_thread::sleep_for(20ms);
+    ASSERT_FALSE(cache->get("k"));
+    ASSERT_EQ(0, cache->size());
+}
+
+TEST(CacheTest, Evict) {
+    auto const cache = Cache::Builder{}.maxSize(2).share();
+    cache->put("k1", "chan", std::make_shared<int const>(1));
+    cache->put("k2", "chan", std::make_shared<int const>(2));
+    ASSERT_TRUE(cache->get("k1"));
+    cache->put("k3", "chan", std::make_shared<int const>(3));
+    ASSERT_EQ(2, cache->size());
+    ASSERT_TRUE(cache->get("k1"));
+    ASSERT_FALSE(cache->get("k2"));
+    ASSERT_TRUE(cache->get("k3"));
+}
+
+TEST(CacheTest, EraseValue) {
+    auto const cache = Cache::Builder{}.share();
+    auto const old   = std::make_shared<int const>(1);
+    cache->put("k1", "chan1", old);
+    cache->put("k1", "chan1", std::make_shared<int const>(2));
+    cache->erase("k1", old);
+    ASSERT_EQ(1, cache->size());
+
+    cache->erase("k1", cache->get("k1"));
+    ASSERT_EQ(0, cache->size());
+}
+
+TEST(CacheTest, Invalidate) {
+    auto const cache = Cache::Builder{}.share();
+    cache->put("k1", "chan1", std::make_shared<int const>(1));
+    cache->put("k2", "chan2", std::make_shared<int const>(2));
+    cache->put("k3", "chan1", std::make_shared<int const>(3));
+    cache->invalidate("chan1");
+    ASSERT_EQ(1, cache->size());
+    ASSERT_TRUE(cache->get("k2"));
+
+    cache->clear();
+    ASSERT_EQ(0, cache->size());
+}
+
+}  // namespace postgres
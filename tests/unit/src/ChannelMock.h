@@ -9,9 +9,13 @@ class ChannelMock : public IChannel {
 public:
     MOCK_METHOD1(quit, void(int));
     MOCK_METHOD1(send, std::tuple<bool, Worker*>(Job));
+    MOCK_METHOD2(trySend, std::optional<std::tuple<bool, Worker*>>(Job, Job::Clock::time_point));
+    MOCK_METHOD1(retry, void(Job));
     MOCK_METHOD1(receive, void(Slot&));
     MOCK_METHOD1(recycle, void(Worker&));
+    MOCK_METHOD3(fail, Job::Clock::duration(Worker&, Slot&, std::exception_ptr const&));
     MOCK_METHOD0(drop, void());
+    MOCK_METHOD0(stats, QueueStats());
 };
 
 }  // namespace postgres::internal
@@ -1,10 +1,14 @@
 #include <future>
+#include <string>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/internal/Channel.h>
 #include <postgres/internal/Worker.h>
+#include <postgres/Connection.h>
 #include <postgres/Context.h>
 #include <postgres/Error.h>
+#include <postgres/FlowConfig.h>
 
 using namespace std::chrono_literals;
 
@@ -99,4 +103,300 @@ TEST(ChannelTest, Overflow) {
     ASSERT_THROW(chan->send(nullptr), RuntimeError);
 }
 
+TEST(ChannelTest, Priority) {
+    auto const ctx  = Context::Builder{}.share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    chan->quit(1);
+    for (auto const prio : {Priority::BULK, Priority::NORMAL, Priority::INTERACTIVE}) {
+        chan->send(Job{[](Connection&) {
+        }, prio, Job::Clock::time_point::max(), {}, nullptr});
+    }
+
+    for (auto const prio : {Priority::INTERACTIVE, Priority::NORMAL, Priority::BULK}) {
+        Slot slot{};
+        chan->receive(slot);
+        ASSERT_TRUE(slot.job);
+        ASSERT_EQ(prio, slot.job.priority());
+    }
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_FALSE(slot.job);
+}
+
+TEST(ChannelTest, Aging) {
+    auto const ctx  = Context::Builder{}.agingInterval(1ms).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    chan->send(Job{[](Connection&) {
+    }, Priority::BULK, Job::Clock::time_point::max(), {}, nullptr});
+    std::this_thread::sleep_for(5ms);
+    chan->send(Job{[](Connection&) {
+    }, Priority::INTERACTIVE, Job::Clock::time_point::max(), {}, nullptr});
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_EQ(Priority::BULK, slot.job.priority());
+}
+
+TEST(ChannelTest, LaneOverflow) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(Priority::BULK, 1).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    auto const send = [&chan](Priority const prio) {
+        chan->send(Job{[](Connection&) {
+        }, prio, Job::Clock::time_point::max(), {}, nullptr});
+    };
+
+    send(Priority::BULK);
+    ASSERT_THROW(send(Priority::BULK), RuntimeError);
+    send(Priority::NORMAL);
+    send(Priority::NORMAL);
+    ASSERT_EQ(1u, chan->stats().rejected);
+    ASSERT_EQ(3u, chan->stats().size);
+}
+
+static Job makeJob(std::string flow) {
+    return Job{[](Connection&) {
+    }, Priority::NORMAL, Job::Clock::time_point::max(), std::move(flow), nullptr};
+}
+
+TEST(ChannelTest, FairShare) {
+    FlowConfig cfg{};
+    cfg.weight = 2;
+
+    auto const ctx  = Context::Builder{}.flow("a", cfg).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    for (auto const flow : {"a", "a", "a", "a", "b", "b"}) {
+        chan->send(makeJob(flow));
+    }
+
+    for (auto const flow : {"a", "a", "b", "a", "a", "b"}) {
+        Slot slot{};
+        chan->receive(slot);
+        ASSERT_EQ(flow, slot.job.flow());
+    }
+}
+
+TEST(ChannelTest, RateLimit) {
+    FlowConfig cfg{};
+    cfg.rate  = 0.001;
+    cfg.burst = 2;
+
+    auto const ctx  = Context::Builder{}.defaultFlow(cfg).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(makeJob("a"));
+    chan->send(makeJob("a"));
+    ASSERT_THROW(chan->send(makeJob("a")), RuntimeError);
+    chan->send(makeJob("b"));
+
+    auto const stats = chan->stats();
+    ASSERT_EQ(3u, stats.accepted);
+    ASSERT_EQ(1u, stats.rejected);
+}
+
+TEST(ChannelTest, RateLimitPrune) {
+    FlowConfig cfg{};
+    cfg.rate  = 0.001;
+    cfg.burst = 1;
+
+    auto const ctx  = Context::Builder{}.defaultFlow(cfg).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(makeJob("a"));
+
+    // Flows with tokens outstanding are still limited after many others have come and gone.
+    for (auto i = 0; i < 1000; ++i) {
+        chan->send(makeJob("b" + std::to_string(i)));
+    }
+    ASSERT_THROW(chan->send(makeJob("a")), RuntimeError);
+}
+
+TEST(ChannelTest, FlowConcurrency) {
+    FlowConfig cfg{};
+    cfg.max_concurrency = 1;
+
+    auto const ctx  = Context::Builder{}.flow("a", cfg).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(makeJob("a"));
+    chan->send(makeJob("a"));
+    chan->send(makeJob("b"));
+
+    Slot first{};
+    chan->receive(first);
+    ASSERT_EQ("a", first.job.flow());
+
+    Slot second{};
+    chan->receive(second);
+    ASSERT_EQ("b", second.job.flow());
+
+    Slot        third{};
+    std::thread waiter{[&chan, &third] {
+        chan->receive(third);
+    }};
+    first.job = nullptr;
+    waiter.join();
+    ASSERT_EQ("a", third.job.flow());
+}
+
+TEST(ChannelTest, TrySend) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    ASSERT_TRUE(chan->trySend(makeJob("a"), Job::Clock::now()));
+    ASSERT_FALSE(chan->trySend(makeJob("a"), Job::Clock::now()));
+    ASSERT_FALSE(chan->trySend(makeJob("a"), Job::Clock::now() + 10ms));
+    ASSERT_EQ(2u, chan->stats().rejected);
+}
+
+TEST(ChannelTest, Block) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(makeJob("a"));
+
+    auto res = std::async(std::launch::async, [&chan] {
+        return chan->trySend(makeJob("b"), Job::Clock::time_point::max()).has_value();
+    });
+    ASSERT_EQ(std::future_status::timeout, res.wait_for(10ms));
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_TRUE(res.get());
+    ASSERT_EQ(1u, chan->stats().size);
+}
+
+TEST(ChannelTest, Watermarks) {
+    auto const ctx  = Context::Builder{}.watermarks(1, 3).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    for (auto i = 0; i < 3; ++i) {
+        ASSERT_FALSE(chan->stats().is_congested);
+        chan->send(makeJob("a"));
+    }
+    ASSERT_TRUE(chan->stats().is_congested);
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_TRUE(chan->stats().is_congested);
+    chan->receive(slot);
+    ASSERT_FALSE(chan->stats().is_congested);
+}
+
+TEST(ChannelTest, Validation) {
+    auto const ctx  = Context::Builder{}.idleTimeout(50ms).validationInterval(10ms).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot       slot{};
+    auto       probes = 0;
+    auto const start  = Job::Clock::now();
+    while (true) {
+        chan->receive(slot);
+        auto const job = std::move(slot.job);
+        if (!job) {
+            break;
+        }
+        ASSERT_TRUE(slot.is_probed);
+        ++probes;
+    }
+    ASSERT_LE(50ms, Job::Clock::now() - start);
+    ASSERT_LE(2, probes);
+}
+
+TEST(ChannelTest, Probe) {
+    auto const ctx  = Context::Builder{}.validationInterval(10ms).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    Slot slot{};
+    chan->receive(slot);
+    auto const probe = std::move(slot.job);
+    ASSERT_TRUE(slot.is_probed);
+
+    Connection conn{};
+    probe(conn);
+    ASSERT_TRUE(conn.isOk());
+
+    // Lost connections are detected without throwing.
+    PQclear(PQexec(conn.native(), "SELECT pg_terminate_backend(pg_backend_pid())"));
+    ASSERT_NO_THROW(probe(conn));
+    ASSERT_FALSE(conn.isOk());
+}
+
+TEST(ChannelTest, ConnectFail) {
+    auto const ctx  = Context::Builder{}.maxConnectAttempts(2).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    std::exception_ptr failed{};
+    chan->send(Job{[](Connection&) {
+    }, Priority::NORMAL, Job::Clock::time_point::max(), {}, nullptr, [&failed](std::exception_ptr err) {
+        failed = std::move(err);
+    }});
+
+    Worker     worker{ctx, chan};
+    Slot       slot{};
+    auto const err = std::make_exception_ptr(RuntimeError{"fail to connect"});
+    ASSERT_LT(0, chan->fail(worker, slot, err).count());
+    ASSERT_FALSE(failed);
+
+    // Out of attempts, the queued job gets the error and the worker gives up.
+    ASSERT_EQ(0, chan->fail(worker, slot, err).count());
+    ASSERT_EQ(err, failed);
+    ASSERT_EQ(0u, chan->stats().size);
+}
+
+TEST(ChannelTest, Expire) {
+    auto const ctx  = Context::Builder{}.share();
+    auto const chan = std::make_shared<Channel>(ctx);
+
+    auto is_expired = false;
+    chan->send(Job{[](Connection&) {
+    }, Priority::NORMAL, Job::Clock::now(), {}, [&is_expired] {
+        is_expired = true;
+    }});
+    chan->send([](Connection&) {
+    });
+
+    Slot slot{};
+    chan->receive(slot);
+    ASSERT_TRUE(is_expired);
+    ASSERT_TRUE(slot.job);
+    ASSERT_EQ(Job::Clock::time_point::max(), slot.job.deadline());
+
+    auto const stats = chan->stats();
+    ASSERT_EQ(2u, stats.accepted);
+    ASSERT_EQ(0u, stats.rejected);
+    ASSERT_EQ(1u, stats.expired);
+    ASSERT_EQ(0u, stats.size);
+}
+
+TEST(ChannelTest, EarliestDeadline) {
+    auto const ctx  = Context::Builder{}.queuePolicy(QueuePolicy::EARLIEST_DEADLINE).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    auto const now  = Job::Clock::now();
+
+    for (auto const deadline : {now + 1h, Job::Clock::time_point::max(), now + 1min, now + 1h}) {
+        chan->send(Job{[](Connection&) {
+        }, Priority::NORMAL, deadline, {}, nullptr});
+    }
+    ASSERT_EQ(4u, chan->stats().size);
+
+    for (auto const deadline : {now + 1min, now + 1h, now + 1h, Job::Clock::time_point::max()}) {
+        Slot slot{};
+        chan->receive(slot);
+        ASSERT_EQ(deadline, slot.job.deadline());
+    }
+}
+
+TEST(ChannelTest, OverflowExpired) {
+    auto const ctx  = Context::Builder{}.maxQueueSize(1).share();
+    auto const chan = std::make_shared<Channel>(ctx);
+    chan->send(Job{[](Connection&) {
+    }, Priority::NORMAL, Job::Clock::now(), {}, nullptr});
+    chan->send([](Connection&) {
+    });
+    ASSERT_THROW(chan->send(nullptr), RuntimeError);
+
+    auto const stats = chan->stats();
+    ASSERT_EQ(2u, stats.accepted);
+    ASSERT_EQ(1u, stats.rejected);
+    ASSERT_EQ(1u, stats.expired);
+    ASSERT_EQ(1u, stats.size);
+}
+
 }  // namespace postgres::internal
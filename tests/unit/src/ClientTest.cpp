@@ -1,11 +1,29 @@
+#include <atomic>
+#include <thread>
 #include <vector>
 #include <gtest/gtest.h>
+#include <postgres/Cache.h>
 #include <postgres/Client.h>
 #include <postgres/Command.h>
 #include <postgres/Connection.h>
+#include <postgres/Context.h>
+#include <postgres/Error.h>
+#include <postgres/JobOptions.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+#include <postgres/Visitable.h>
+#include "Samples.h"
+
+using namespace std::chrono_literals;
 
 namespace postgres {
 
+struct ClientTestRow {
+    int32_t id = 0;
+
+    POSTGRES_CXX_TABLE("client_test", id);
+};
+
 TEST(ClientTest, Result) {
     Client cl{};
     ASSERT_TRUE(cl.exec([](Connection& conn) {
@@ -19,6 +37,57 @@ TEST(ClientTest, Result) {
     }).get(), RuntimeError);
 }
 
+TEST(ClientTest, ConnectBad) {
+    Client cl{Context::Builder{}.uri("postgresql://127.0.0.1:1/db")
+                                .connectBackoff(1ms, 10ms)
+                                .maxConnectAttempts(3)
+                                .build()};
+    auto   res = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    });
+    ASSERT_EQ(std::future_status::ready, res.wait_for(3s));
+    ASSERT_THROW(res.get(), RuntimeError);
+
+    // Later jobs fail after a single attempt while the server is unreachable.
+    ASSERT_THROW(cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    }).get(), RuntimeError);
+}
+
+TEST(ClientTest, Timeout) {
+    Client cl{Context::Builder{}.maxConcurrency(1).build()};
+    auto   slow = cl.exec([](Connection& conn) {
+        return conn.exec("SELECT pg_sleep(10)");
+    }, 100ms);
+    auto   queued = cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1");
+    }, 50ms);
+    ASSERT_THROW(slow.get(), TimeoutError);
+    ASSERT_THROW(queued.get(), TimeoutError);
+    ASSERT_EQ(1, cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    }, 1s).get()[0][0].as<int32_t>());
+}
+
+TEST(ClientTest, Retry) {
+    Client cl{Context::Builder{}.connectBackoff(1ms, 10ms).build()};
+    auto   attempts = std::make_shared<std::atomic<int>>(0);
+    auto   job      = [attempts](Connection& conn) {
+        if (attempts->fetch_add(1) == 0) {
+            conn.exec("SELECT pg_terminate_backend(pg_backend_pid())");
+        }
+        return conn.exec("SELECT 1::INT");
+    };
+    ASSERT_EQ(1, cl.query(job, JobOptions{}.retries(1)).get()[0][0].as<int32_t>());
+    ASSERT_EQ(2, attempts->load());
+
+    *attempts = 0;
+    ASSERT_THROW(cl.query(job).get(), RuntimeError);
+    ASSERT_THROW(cl.query([](Connection& conn) {
+        return conn.exec("BAD");
+    }, JobOptions{}.retries(3)).get(), SqlError);
+}
+
 TEST(ClientTest, Load) {
     auto constexpr                   N = 64;
     Client                           cl{};
@@ -37,4 +106,112 @@ TEST(ClientTest, Load) {
     ASSERT_EQ(2080, sum);
 }
 
+TEST(ClientTest, Concurrent) {
+    auto constexpr           N = 8;
+    auto constexpr           M = 16;
+    Client                   cl{Context::Builder{}.maxConcurrency(4).build()};
+    std::vector<std::thread> threads{};
+    std::vector<int>         sums(N);
+
+    for (auto t = 0; t < N; ++t) {
+        threads.emplace_back([&cl, &sum = sums[t]] {
+            std::vector<std::future<Result>> results{};
+            for (auto i = 1; i <= M; ++i) {
+                results.push_back(cl.query([i](Connection& conn) {
+                    return conn.exec(Command{"SELECT $1", i});
+                }));
+            }
+            for (auto& res : results) {
+                sum += res.get()[0][0].as<int32_t>();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const sum : sums) {
+        ASSERT_EQ(136, sum);
+    }
+}
+
+TEST(ClientTest, Shared) {
+    Client     cl{};
+    auto const slow = "SELECT pg_sleep(0.1), $1::INT";
+    auto       res1 = cl.queryShared(Command{slow, 1});
+    auto       res2 = cl.queryShared(Command{slow, 1});
+    auto       res3 = cl.queryShared(Command{slow, 2});
+    ASSERT_EQ(&res1.get(), &res2.get());
+    ASSERT_NE(&res1.get(), &res3.get());
+    ASSERT_EQ(1, res2.get()[0][1].as<int32_t>());
+    ASSERT_EQ(2, res3.get()[0][1].as<int32_t>());
+    ASSERT_THROW(cl.queryShared(Command{"BAD"}).get(), RuntimeError);
+}
+
+TEST(ClientTest, SharedPrepared) {
+    Client cl{Context::Builder{}.prepare(PrepareData{"select1", "SELECT $1::INT", {INT4OID}})
+                                .build()};
+    auto   res1 = cl.queryShared(PreparedCommand{"select1", 1});
+    auto   res2 = cl.queryShared(Command{"select1", 1});
+    ASSERT_EQ(1, res1.get()[0][0].as<int32_t>());
+    ASSERT_THROW(res2.get(), RuntimeError);
+}
+
+TEST(ClientTest, Cache) {
+    Connection conn{};
+    conn.drop<ClientTestRow>();
+    conn.create<ClientTestRow>();
+    conn.insert(ClientTestRow{1});
+
+    auto const cache = Cache::Builder{}.listen(CONNECT_STR).share();
+    Client     cl{Context::Builder{}.cache(cache).build()};
+
+    // Nothing is cached until the table channel is listened.
+    for (auto i = 0; (i < 100) && (cache->size() == 0); ++i) {
+        cl.select<ClientTestRow>().wait();
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    auto res1 = cl.select<ClientTestRow>();
+    auto res2 = cl.select<ClientTestRow>();
+    ASSERT_EQ(&res1.get(), &res2.get());
+    ASSERT_EQ(1u, res1.get().size());
+    ASSERT_EQ(1, cache->size());
+
+    conn.insert(ClientTestRow{2});
+    conn.exec(Command{"SELECT pg_notify($1, '')", "client_test"});
+    for (auto i = 0; (i < 100) && (0 < cache->size()); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    ASSERT_EQ(2u, cl.select<ClientTestRow>().get().size());
+    conn.drop<ClientTestRow>();
+}
+
+TEST(ClientTest, Stream) {
+    Client cl{};
+    auto   n   = 0;
+    auto   sum = 0;
+    for (auto const& row : cl.stream(Command{"SELECT generate_series(1, $1)", 1000}, 64, 2)) {
+        ++n;
+        sum += row[0].as<int32_t>();
+    }
+    ASSERT_EQ(1000, n);
+    ASSERT_EQ(500500, sum);
+}
+
+TEST(ClientTest, StreamAbandon) {
+    Client cl{Context::Builder{}.maxConcurrency(1).build()};
+    {
+        auto stream = cl.stream(Command{"SELECT generate_series(1, 100000)"}, 10, 1);
+        ASSERT_EQ(1, (*stream.begin())[0].as<int32_t>());
+    }
+    ASSERT_EQ(1, cl.query([](Connection& conn) {
+        return conn.exec("SELECT 1::INT");
+    }).get()[0][0].as<int32_t>());
+}
+
+TEST(ClientTest, StreamBad) {
+    Client cl{};
+    auto   stream = cl.stream(Command{"BAD"});
+    ASSERT_THROW(stream.chunk(), RuntimeError);
+}
+
 }  // namespace postgres
@@ -15,6 +15,13 @@ struct CommandTestTable {
     POSTGRES_CXX_TABLE("cmd_test", s, n, f);
 };
 
+struct CommandTestSerialTable {
+    uint32_t id = 0;
+    int32_t  n  = 0;
+
+    POSTGRES_CXX_TABLE("cmd_serial_test", id, n);
+};
+
 TEST(CommandTest, Stmt) {
     auto const    stmt = "STMT";
     Command const cmd{stmt};
@@ -35,6 +42,13 @@ TEST(CommandTest, StmtOwn) {
     ASSERT_STREQ("STMT", cmd.statement());
 }
 
+TEST(CommandTest, StmtOwnMove) {
+    Command       cmd{std::string{"STMT"}, 1};
+    Command const moved{std::move(cmd)};
+    ASSERT_STREQ("STMT", moved.statement());
+    ASSERT_EQ(1, moved.count());
+}
+
 TEST(CommandTest, NoArgs) {
     Command const cmd{"STMT"};
     ASSERT_STREQ("STMT", cmd.statement());
@@ -282,6 +296,55 @@ TEST(CommandTest, Visit) {
     ASSERT_EQ(1, cmd.formats()[2]);
 }
 
+TEST(CommandTest, InsertRange) {
+    std::vector<CommandTestSerialTable> const arr{{7, 1}, {8, 2}};
+    using Iter = decltype(arr.begin());
+
+    Command const cmd{"STMT", internal::InsertRange<Iter>{arr.begin(), arr.end()}};
+    ASSERT_STREQ("STMT", cmd.statement());
+    ASSERT_EQ(2, cmd.count());
+
+    ASSERT_EQ(Oid{INT4OID}, cmd.types()[0]);
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(cmd.values()[0]));
+    ASSERT_EQ(Oid{INT4OID}, cmd.types()[1]);
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(cmd.values()[1]));
+}
+
+TEST(CommandTest, Array) {
+    std::vector<int32_t> const arr{1, 2};
+    Command const              cmd{"STMT", arr};
+    ASSERT_EQ(1, cmd.count());
+    ASSERT_EQ(Oid{INT4ARRAYOID}, cmd.types()[0]);
+    ASSERT_EQ(36, cmd.lengths()[0]);
+    ASSERT_EQ(1, cmd.formats()[0]);
+
+    auto const data = cmd.values()[0];
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(data));
+    ASSERT_EQ(0, internal::orderBytes<int32_t>(data + 4));
+    ASSERT_EQ(INT4OID, internal::orderBytes<int32_t>(data + 8));
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(data + 12));
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(data + 16));
+    ASSERT_EQ(4, internal::orderBytes<int32_t>(data + 20));
+    ASSERT_EQ(1, internal::orderBytes<int32_t>(data + 24));
+    ASSERT_EQ(4, internal::orderBytes<int32_t>(data + 28));
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(data + 32));
+}
+
+TEST(CommandTest, StrArray) {
+    std::vector<std::string> const arr{"AB", ""};
+    Command const                  cmd{"STMT", arr, int16_t{3}};
+    ASSERT_EQ(2, cmd.count());
+    ASSERT_EQ(Oid{TEXTARRAYOID}, cmd.types()[0]);
+    ASSERT_EQ(30, cmd.lengths()[0]);
+
+    auto const data = cmd.values()[0];
+    ASSERT_EQ(TEXTOID, internal::orderBytes<int32_t>(data + 8));
+    ASSERT_EQ(2, internal::orderBytes<int32_t>(data + 20));
+    ASSERT_EQ("AB", std::string(data + 24, 2));
+    ASSERT_EQ(0, internal::orderBytes<int32_t>(data + 26));
+    ASSERT_EQ(3, internal::orderBytes<int16_t>(cmd.values()[1]));
+}
+
 TEST(CommandTest, MultiArgs) {
     Command const cmd{"STMT", std::string{"TEXT"}, int32_t{3}, 4.56};
     ASSERT_STREQ("STMT", cmd.statement());
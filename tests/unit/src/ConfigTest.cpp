@@ -143,6 +143,17 @@ TEST(ConfigTest, Manual) {
     ASSERT_STREQ(v[i], "0");
 }
 
+TEST(ConfigTest, Replication) {
+    std::map<ReplicationMode, std::string> const samples{{ReplicationMode::PHYSICAL, "true"},
+                                                         {ReplicationMode::LOGICAL,  "database"},
+                                                         {ReplicationMode::DEFAULT,  "false"}};
+
+    for (auto const& sample : samples) {
+        auto const c = Config::Builder{}.replication(sample.first).build();
+        ASSERT_EQ(sample.second, c.values()[0]);
+    }
+}
+
 TEST(ConfigTest, SslMode) {
     std::map<SslMode, std::string> const samples{{SslMode::ALLOW,       "allow"},
                                                  {SslMode::DISABLE,     "disable"},
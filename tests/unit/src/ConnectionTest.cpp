@@ -57,6 +57,16 @@ TEST(ConnectionTest, Exec) {
     ASSERT_THROW(conn.exec("BAD"), RuntimeError);
 }
 
+TEST(ConnectionTest, SqlState) {
+    Connection conn{};
+    try {
+        conn.exec("BAD");
+        FAIL();
+    } catch (SqlError const& e) {
+        ASSERT_EQ("42601", e.sqlState());
+    }
+}
+
 TEST(ConnectionTest, ExecRaw) {
     Connection conn{};
     ASSERT_TRUE(conn.execRaw("SELECT 1").isOk());
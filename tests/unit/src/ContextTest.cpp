@@ -13,28 +13,115 @@ namespace postgres {
 TEST(ContextTest, Default) {
     Context const ctx{};
     ASSERT_EQ(0, ctx.idleTimeout().count());
+    ASSERT_EQ(0, ctx.maxLifetime().count());
+    ASSERT_EQ(0, ctx.validationInterval().count());
     ASSERT_LT(0, ctx.maxConcurrency());
+    ASSERT_EQ(0, ctx.minConcurrency());
+    ASSERT_EQ(0, ctx.targetWait().count());
+    ASSERT_EQ(0, ctx.scalingInterval().count());
+    ASSERT_EQ(1, ctx.maxConnecting());
+    ASSERT_LT(0, ctx.minBackoff().count());
+    ASSERT_LE(ctx.minBackoff(), ctx.maxBackoff());
+    ASSERT_LT(0, ctx.maxConnectAttempts());
     ASSERT_EQ(0, ctx.maxQueueSize());
+    ASSERT_EQ(0, ctx.maxQueueSize(Priority::BULK));
+    ASSERT_EQ(0, ctx.agingInterval().count());
+    ASSERT_EQ(0, ctx.lowWatermark());
+    ASSERT_EQ(0, ctx.highWatermark());
     ASSERT_EQ(ShutdownPolicy::GRACEFUL, ctx.shutdownPolicy());
+    ASSERT_EQ(AbandonPolicy::DRAIN, ctx.abandonPolicy());
+    ASSERT_EQ(QueuePolicy::FIFO, ctx.queuePolicy());
+    ASSERT_EQ(1, ctx.flow("a").weight);
+    ASSERT_EQ(0.0, ctx.flow("a").rate);
+    ASSERT_EQ(0, ctx.flow("a").max_concurrency);
 }
 
 TEST(ContextTest, Values) {
     auto const ctx = Context::Builder{}.idleTimeout(1s)
+                                       .maxLifetime(1h)
+                                       .validationInterval(30s)
                                        .maxConcurrency(2)
+                                       .minConcurrency(1)
+                                       .targetWait(10ms)
+                                       .scalingInterval(3s)
+                                       .maxConnecting(2)
+                                       .connectBackoff(1s, 4s)
+                                       .maxConnectAttempts(0)
                                        .maxQueueSize(3)
+                                       .maxQueueSize(Priority::BULK, 4)
+                                       .agingInterval(2s)
+                                       .watermarks(5, 6)
                                        .shutdownPolicy(ShutdownPolicy::DROP)
+                                       .abandonPolicy(AbandonPolicy::CANCEL)
+                                       .queuePolicy(QueuePolicy::EARLIEST_DEADLINE)
                                        .build();
     ASSERT_EQ(1s, ctx.idleTimeout());
+    ASSERT_EQ(1h, ctx.maxLifetime());
+    ASSERT_EQ(30s, ctx.validationInterval());
     ASSERT_EQ(2, ctx.maxConcurrency());
+    ASSERT_EQ(1, ctx.minConcurrency());
+    ASSERT_EQ(10ms, ctx.targetWait());
+    ASSERT_EQ(3s, ctx.scalingInterval());
+    ASSERT_EQ(2, ctx.maxConnecting());
+    ASSERT_EQ(1s, ctx.minBackoff());
+    ASSERT_EQ(4s, ctx.maxBackoff());
+    ASSERT_EQ(0, ctx.maxConnectAttempts());
     ASSERT_EQ(3, ctx.maxQueueSize());
+    ASSERT_EQ(4, ctx.maxQueueSize(Priority::BULK));
+    ASSERT_EQ(0, ctx.maxQueueSize(Priority::INTERACTIVE));
+    ASSERT_EQ(2s, ctx.agingInterval());
+    ASSERT_EQ(5, ctx.lowWatermark());
+    ASSERT_EQ(6, ctx.highWatermark());
     ASSERT_EQ(ShutdownPolicy::DROP, ctx.shutdownPolicy());
+    ASSERT_EQ(AbandonPolicy::CANCEL, ctx.abandonPolicy());
+    ASSERT_EQ(QueuePolicy::EARLIEST_DEADLINE, ctx.queuePolicy());
+}
+
+TEST(ContextTest, Flow) {
+    FlowConfig a{};
+    a.weight = 3;
+    FlowConfig other{};
+    other.max_concurrency = 2;
+
+    auto const ctx = Context::Builder{}.flow("a", a).defaultFlow(other).build();
+    ASSERT_EQ(3, ctx.flow("a").weight);
+    ASSERT_EQ(0, ctx.flow("a").max_concurrency);
+    ASSERT_EQ(1, ctx.flow("b").weight);
+    ASSERT_EQ(2, ctx.flow("b").max_concurrency);
 }
 
 TEST(ContextTest, Bad) {
     ASSERT_THROW(Context::Builder{}.idleTimeout(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.maxLifetime(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.validationInterval(-1s).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxConcurrency(-1).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxConcurrency(0).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.minConcurrency(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.maxConcurrency(1).minConcurrency(2).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.targetWait(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.scalingInterval(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.maxConnecting(0).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.connectBackoff(0s, 1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.connectBackoff(2s, 1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.maxConnectAttempts(-1).build(), LogicError);
     ASSERT_THROW(Context::Builder{}.maxQueueSize(-1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.maxQueueSize(Priority::BULK, -1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.agingInterval(-1s).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.watermarks(-1, 1).build(), LogicError);
+    ASSERT_THROW(Context::Builder{}.watermarks(2, 2).build(), LogicError);
+
+    FlowConfig cfg{};
+    cfg.weight = 0;
+    ASSERT_THROW(Context::Builder{}.flow("a", cfg).build(), LogicError);
+    cfg = FlowConfig{};
+    cfg.rate = -1.0;
+    ASSERT_THROW(Context::Builder{}.defaultFlow(cfg).build(), LogicError);
+    cfg = FlowConfig{};
+    cfg.burst = 0;
+    ASSERT_THROW(Context::Builder{}.defaultFlow(cfg).build(), LogicError);
+    cfg = FlowConfig{};
+    cfg.max_concurrency = -1;
+    ASSERT_THROW(Context::Builder{}.flow("a", cfg).build(), LogicError);
 }
 
 TEST(ContextTest, Connect) {
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <postgres/internal/Controller.h>
+#include <postgres/Context.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres::internal {
+
+TEST(ControllerTest, Bounds) {
+    Controller ctl{Context::Builder{}.minConcurrency(2).maxConcurrency(3).targetWait(1s).share()};
+    auto const now = Controller::Clock::now();
+    ASSERT_TRUE(ctl.grow(0, 0, now));
+    ASSERT_TRUE(ctl.grow(1, 0, now));
+    ASSERT_FALSE(ctl.grow(2, 0, now));
+    ASSERT_FALSE(ctl.grow(3, 0, now));
+    ASSERT_FALSE(ctl.shrink(2, now + 1h));
+}
+
+TEST(ControllerTest, Wait) {
+    Controller ctl{Context::Builder{}.maxConcurrency(4).targetWait(10ms).share()};
+    auto const now = Controller::Clock::now();
+    ASSERT_FALSE(ctl.grow(1, 0, now));
+
+    for (auto i = 0; i < 16; ++i) {
+        ctl.onWait(100ms);
+    }
+    ASSERT_LT(10ms, ctl.wait());
+    ASSERT_TRUE(ctl.grow(1, 0, now));
+
+    for (auto i = 0; i < 64; ++i) {
+        ctl.onWait(0ms);
+    }
+    ASSERT_GE(10ms, ctl.wait());
+    ASSERT_FALSE(ctl.grow(2, 0, now));
+}
+
+TEST(ControllerTest, Interval) {
+    Controller ctl{Context::Builder{}.maxConcurrency(4).scalingInterval(1s).share()};
+    auto const now = Controller::Clock::now();
+    ASSERT_TRUE(ctl.grow(1, 0, now));
+    ASSERT_FALSE(ctl.grow(2, 0, now + 500ms));
+    ASSERT_TRUE(ctl.grow(2, 0, now + 1s));
+}
+
+TEST(ControllerTest, Connecting) {
+    Controller ctl{Context::Builder{}.maxConcurrency(4).maxConnecting(2).share()};
+    auto const now = Controller::Clock::now();
+    ASSERT_TRUE(ctl.grow(0, 1, now));
+    ASSERT_FALSE(ctl.grow(0, 2, now));
+    ASSERT_FALSE(ctl.grow(2, 2, now));
+    ASSERT_FALSE(ctl.grow(3, 1, now));
+}
+
+TEST(ControllerTest, Backoff) {
+    Controller ctl{Context::Builder{}.maxConcurrency(4).connectBackoff(100ms, 300ms).share()};
+    auto const now   = Controller::Clock::now();
+    auto const first = ctl.fail(now);
+    ASSERT_LE(50ms, first);
+    ASSERT_GE(100ms, first);
+    ASSERT_FALSE(ctl.grow(1, 0, now));
+    ASSERT_TRUE(ctl.grow(0, 0, now));
+    ASSERT_TRUE(ctl.grow(1, 0, now + first));
+
+    auto const second = ctl.fail(now);
+    ASSERT_LE(100ms, second);
+    ASSERT_GE(200ms, second);
+    auto const third = ctl.fail(now);
+    ASSERT_LE(150ms, third);
+    ASSERT_GE(300ms, third);
+
+    ctl.succeed();
+    ASSERT_GE(100ms, ctl.fail(now));
+}
+
+TEST(ControllerTest, Shrink) {
+    Controller ctl{Context::Builder{}.maxConcurrency(4).idleTimeout(1s).share()};
+    auto const now = Controller::Clock::now();
+    ASSERT_TRUE(ctl.grow(1, 0, now));
+    ASSERT_FALSE(ctl.shrink(2, now + 500ms));
+    ASSERT_TRUE(ctl.shrink(2, now + 1s));
+    ASSERT_FALSE(ctl.shrink(1, now + 1500ms));
+    ASSERT_TRUE(ctl.shrink(1, now + 2s));
+    ASSERT_FALSE(ctl.shrink(0, now + 1h));
+
+    for (auto i = 0; i < 16; ++i) {
+        ctl.onLoad(3, 4);
+    }
+    ASSERT_LT(0.5, ctl.load());
+    ASSERT_FALSE(ctl.shrink(4, now + 1h));
+}
+
+}  // namespace postgres::internal
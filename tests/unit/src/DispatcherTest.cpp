@@ -2,6 +2,7 @@
 #include <postgres/internal/Dispatcher.h>
 #include <postgres/internal/Worker.h>
 #include <postgres/Context.h>
+#include <postgres/Error.h>
 #include "ChannelFake.h"
 #include "ChannelMock.h"
 
@@ -40,6 +41,22 @@ TEST(DispatcherTest, Drop) {
     disp.send<void>(noop);
 }
 
+TEST(DispatcherTest, Expired) {
+    ChannelFake chan{};
+    auto const  mock = std::make_shared<ChannelMock>();
+    EXPECT_CALL(*mock, send(_)).WillOnce(Invoke(chan.sender(false)));
+    EXPECT_CALL(*mock, receive(_)).Times(2).WillRepeatedly(Invoke(chan.receiver()));
+    EXPECT_CALL(*mock, quit(1)).WillOnce(Invoke(chan.terminator()));
+    EXPECT_CALL(*mock, recycle(_)).WillOnce(Invoke(chan.recycler()));
+    Dispatcher disp{Context::Builder{}.maxConcurrency(1).share(), mock};
+    auto is_called = false;
+    auto res       = disp.send<void>([&is_called](Connection&) {
+        is_called = true;
+    }, Priority::NORMAL, Job::Clock::now(), {}, 0);
+    ASSERT_THROW(res.get(), TimeoutError);
+    ASSERT_FALSE(is_called);
+}
+
 TEST(DispatcherTest, Recycle) {
     ChannelFake chan{};
     auto const  mock = std::make_shared<ChannelMock>();
@@ -0,0 +1,59 @@
+#include <future>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Client.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Loader.h>
+#include <postgres/Visitable.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+inline auto constexpr LOADER_SELECT = "SELECT id, id * 10 AS val"
+                                      " FROM generate_series(1, 3) AS id"
+                                      " WHERE id = ANY($1)";
+
+struct LoaderTestRow {
+    int32_t id  = 0;
+    int32_t val = 0;
+
+    POSTGRES_CXX_TABLE("loader_test", id, val);
+};
+
+TEST(LoaderTest, Batch) {
+    Client                         cl{};
+    Loader<LoaderTestRow, int32_t> loader{cl, LOADER_SELECT, "id", 10ms};
+
+    auto one   = loader.load(1);
+    auto three = loader.load(3);
+    auto again = loader.load(1);
+    auto none  = loader.load(4);
+
+    auto const res = one.get();
+    ASSERT_EQ(1u, res.size());
+    ASSERT_EQ(10, res[0].val);
+    ASSERT_EQ(30, three.get()[0].val);
+    ASSERT_EQ(10, again.get()[0].val);
+    ASSERT_TRUE(none.get().empty());
+}
+
+TEST(LoaderTest, Cap) {
+    Client                         cl{};
+    Loader<LoaderTestRow, int32_t> loader{cl, LOADER_SELECT, "id", 1h, 2};
+
+    auto one = loader.load(1);
+    auto two = loader.load(2);
+    ASSERT_EQ(std::future_status::ready, one.wait_for(1min));
+    ASSERT_EQ(20, two.get()[0].val);
+}
+
+TEST(LoaderTest, Bad) {
+    Client                         cl{};
+    Loader<LoaderTestRow, int32_t> loader{cl, "BAD", "id"};
+    ASSERT_THROW(loader.load(1).get(), RuntimeError);
+}
+
+}  // namespace postgres
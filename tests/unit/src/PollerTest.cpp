@@ -0,0 +1,102 @@
+#include <vector>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <unistd.h>
+#include <postgres/internal/Poller.h>
+
+namespace postgres::internal {
+
+class PollerTest : public testing::TestWithParam<EventBackend> {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(0, ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC));
+    }
+
+    void TearDown() override {
+        ::close(pipe_[0]);
+        ::close(pipe_[1]);
+    }
+
+    int pipe_[2] = {-1, -1};
+};
+
+TEST_P(PollerTest, Ready) {
+    auto const                 poller = Poller::create(GetParam());
+    std::vector<Poller::Event> out{};
+
+    poller->watch(pipe_[0], POLLIN);
+    poller->watch(pipe_[1], POLLOUT);
+    poller->wait(out);
+    ASSERT_EQ(1, out.size());
+    ASSERT_EQ(pipe_[1], out[0].fd);
+    ASSERT_TRUE(out[0].events & POLLOUT);
+
+    poller->watch(pipe_[1], 0);
+    char const byte = 0;
+    ASSERT_EQ(1, ::write(pipe_[1], &byte, 1));
+    out.clear();
+    poller->wait(out);
+    ASSERT_EQ(1, out.size());
+    ASSERT_EQ(pipe_[0], out[0].fd);
+    ASSERT_TRUE(out[0].events & POLLIN);
+
+    // Still readable, so reported again.
+    out.clear();
+    poller->wait(out);
+    ASSERT_EQ(1, out.size());
+    ASSERT_EQ(pipe_[0], out[0].fd);
+}
+
+TEST_P(PollerTest, Change) {
+    auto const                 poller = Poller::create(GetParam());
+    std::vector<Poller::Event> out{};
+
+    poller->watch(pipe_[0], POLLIN);
+    poller->watch(pipe_[1], POLLOUT);
+    poller->wait(out);
+    poller->watch(pipe_[1], POLLIN);
+
+    char const byte = 0;
+    ASSERT_EQ(1, ::write(pipe_[1], &byte, 1));
+    out.clear();
+    poller->wait(out);
+    ASSERT_EQ(1, out.size());
+    ASSERT_EQ(pipe_[0], out[0].fd);
+}
+
+TEST_P(PollerTest, Reopen) {
+    auto const                 poller = Poller::create(GetParam());
+    std::vector<Poller::Event> out{};
+
+    poller->watch(pipe_[0], POLLIN);
+    poller->watch(pipe_[1], POLLOUT);
+    poller->wait(out);
+
+    // The descriptors become ready before they are dropped and reused.
+    char const byte = 0;
+    ASSERT_EQ(1, ::write(pipe_[1], &byte, 1));
+    poller->watch(pipe_[0], 0);
+    poller->watch(pipe_[1], 0);
+    ::close(pipe_[0]);
+    ::close(pipe_[1]);
+    ASSERT_EQ(0, ::pipe2(pipe_, O_NONBLOCK | O_CLOEXEC));
+
+    // Nothing is reported for the new pipe having no data.
+    poller->watch(pipe_[0], POLLIN);
+    poller->watch(pipe_[1], POLLOUT);
+    out.clear();
+    poller->wait(out);
+    ASSERT_EQ(1, out.size());
+    ASSERT_EQ(pipe_[1], out[0].fd);
+}
+
+TEST(PollerTest, Epoll) {
+    ASSERT_EQ(EventBackend::EPOLL, Poller::create(EventBackend::EPOLL)->backend());
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends,
+                         PollerTest,
+                         testing::Values(EventBackend::EPOLL, EventBackend::IO_URING));
+
+}  // namespace postgres::internal
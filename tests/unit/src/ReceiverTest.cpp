@@ -1,3 +1,4 @@
+#include <chrono>
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
@@ -153,4 +154,36 @@ TEST(ReceiverTest, Mix) {
     ASSERT_TRUE(rec1.receive().isDone());
 }
 
+TEST(ReceiverTest, Cancel) {
+    Connection conn{};
+    auto const start = std::chrono::steady_clock::now();
+    auto       rec   = conn.send("SELECT pg_sleep(10)");
+    ASSERT_TRUE(rec.cancel());
+    ASSERT_THROW(rec.receive(), RuntimeError);
+    ASSERT_TRUE(rec.receive().isDone());
+    ASSERT_GT(std::chrono::seconds{5}, std::chrono::steady_clock::now() - start);
+}
+
+TEST(ReceiverTest, Abandon) {
+    Connection conn{};
+    conn.abandonPolicy(AbandonPolicy::CANCEL);
+    auto const start = std::chrono::steady_clock::now();
+    for (auto const& res : conn.iter("SELECT pg_sleep(0.001) FROM generate_series(1, 10000)")) {
+        ASSERT_TRUE(res.isOk());
+        break;
+    }
+    ASSERT_GT(std::chrono::seconds{5}, std::chrono::steady_clock::now() - start);
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+}
+
+TEST(ReceiverTest, AbandonDone) {
+    Connection conn{};
+    conn.abandonPolicy(AbandonPolicy::CANCEL);
+    {
+        auto rec = conn.send("SELECT 1::INT");
+        ASSERT_EQ(1, rec.receive()[0][0].as<int32_t>());
+    }
+    ASSERT_EQ(2, conn.exec("SELECT 2::INT")[0][0].as<int32_t>());
+}
+
 }  // namespace postgres
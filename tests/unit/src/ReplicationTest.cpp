@@ -0,0 +1,245 @@
+#include <optional>
+#include <string>
+#include <gtest/gtest.h>
+#include <postgres/internal/Bytes.h>
+#include <postgres/internal/LogicalDecoder.h>
+#include <postgres/Config.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Replication.h>
+#include <postgres/Visitable.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+struct ReplicationTestRow {
+    int32_t     id    = 0;
+    std::string info;
+    double      score = 0.0;
+    bool        flag  = false;
+    Time::Point ts;
+
+    POSTGRES_CXX_TABLE("replication_test", id, info, score, flag, ts);
+};
+
+class Message {
+public:
+    explicit Message(char const kind)
+        : data_{kind} {
+    }
+
+    template <typename T>
+    Message& add(T const val) {
+        auto const ordered = internal::orderBytes(val);
+        data_.append(reinterpret_cast<char const*>(&ordered), sizeof(ordered));
+        return *this;
+    }
+
+    Message& str(std::string const& val) {
+        data_.append(val.data(), val.size() + 1);
+        return *this;
+    }
+
+    Message& text(std::string const& val) {
+        add('t').add(static_cast<int32_t>(val.size()));
+        data_ += val;
+        return *this;
+    }
+
+    std::string const& data() const {
+        return data_;
+    }
+
+private:
+    std::string data_;
+};
+
+Message makeRelation() {
+    Message msg{'R'};
+    msg.add(Oid{42}).str("public").str("replication_test").add('d').add(int16_t{5});
+    msg.add(int8_t{1}).str("id").add(Oid{INT4OID}).add(int32_t{-1});
+    msg.add(int8_t{0}).str("info").add(Oid{TEXTOID}).add(int32_t{-1});
+    msg.add(int8_t{0}).str("score").add(Oid{FLOAT8OID}).add(int32_t{-1});
+    msg.add(int8_t{0}).str("flag").add(Oid{BOOLOID}).add(int32_t{-1});
+    msg.add(int8_t{0}).str("ts").add(Oid{TIMESTAMPTZOID}).add(int32_t{-1});
+    return msg;
+}
+
+TEST(ReplicationTest, Lsn) {
+    ASSERT_EQ("0/0", formatLsn(0));
+    ASSERT_EQ("16/B374D848", formatLsn(0x16B374D848));
+}
+
+TEST(ReplicationTest, Transaction) {
+    internal::LogicalDecoder decoder{};
+
+    auto begin = decoder.decode(Message{'B'}.add(int64_t{100}).add(int64_t{1000000}).add(uint32_t{7})
+                                            .data(), 90);
+    ASSERT_TRUE(begin);
+    ASSERT_EQ(ChangeType::BEGIN, begin->type());
+    ASSERT_EQ(100u, begin->lsn());
+    ASSERT_EQ(7u, begin->xid());
+    ASSERT_EQ(Time::EPOCH + 1s, begin->time());
+
+    auto commit = decoder.decode(Message{'C'}.add(int8_t{0})
+                                             .add(int64_t{100})
+                                             .add(int64_t{120})
+                                             .add(int64_t{2000000})
+                                             .data(), 110);
+    ASSERT_TRUE(commit);
+    ASSERT_EQ(ChangeType::COMMIT, commit->type());
+    ASSERT_EQ(120u, commit->lsn());
+    ASSERT_EQ(7u, commit->xid());
+    ASSERT_EQ(Time::EPOCH + 2s, commit->time());
+
+    ASSERT_FALSE(decoder.decode(Message{'Y'}.data(), 130));
+}
+
+TEST(ReplicationTest, Relation) {
+    internal::LogicalDecoder decoder{};
+
+    auto const change = decoder.decode(makeRelation().data(), 10);
+    ASSERT_TRUE(change);
+    ASSERT_EQ(ChangeType::RELATION, change->type());
+    ASSERT_TRUE(change->is<ReplicationTestRow>());
+
+    auto const& rel = change->relation();
+    ASSERT_EQ(42u, rel.id);
+    ASSERT_EQ("public", rel.schema);
+    ASSERT_EQ("replication_test", rel.name);
+    ASSERT_EQ(5u, rel.columns.size());
+    ASSERT_EQ("id", rel.columns[0].name);
+    ASSERT_TRUE(rel.columns[0].is_key);
+    ASSERT_FALSE(rel.columns[1].is_key);
+    ASSERT_EQ(static_cast<Oid>(FLOAT8OID), rel.columns[2].type);
+    ASSERT_EQ(4, rel.find("ts"));
+    ASSERT_EQ(-1, rel.find("bad"));
+}
+
+TEST(ReplicationTest, Insert) {
+    internal::LogicalDecoder decoder{};
+    decoder.decode(makeRelation().data(), 10);
+
+    Message msg{'I'};
+    msg.add(Oid{42}).add('N').add(int16_t{5});
+    msg.text("1").text("one").text("1.5").text("t").text("2017-08-25 13:03:35.987654+03");
+
+    auto const change = decoder.decode(msg.data(), 20);
+    ASSERT_TRUE(change);
+    ASSERT_EQ(ChangeType::INSERT, change->type());
+    ASSERT_EQ(20u, change->lsn());
+    ASSERT_FALSE(change->old());
+
+    ReplicationTestRow row{};
+    *change >> row;
+    ASSERT_EQ(1, row.id);
+    ASSERT_EQ("one", row.info);
+    ASSERT_EQ(1.5, row.score);
+    ASSERT_TRUE(row.flag);
+    ASSERT_EQ(Time{"2017-08-25 10:03:35.987654"}.point(), row.ts);
+}
+
+TEST(ReplicationTest, Update) {
+    internal::LogicalDecoder decoder{};
+    decoder.decode(makeRelation().data(), 10);
+
+    Message msg{'U'};
+    msg.add(Oid{42}).add('K').add(int16_t{5});
+    msg.text("1").add('n').add('n').add('n').add('n');
+    msg.add('N').add(int16_t{5});
+    msg.text("2").add('u').text("0.5").text("f").text("2017-08-25 13:03:35");
+
+    auto const change = decoder.decode(msg.data(), 20);
+    ASSERT_TRUE(change);
+    ASSERT_EQ(ChangeType::UPDATE, change->type());
+    ASSERT_TRUE(change->old());
+    ASSERT_EQ("1", change->old()->value(0));
+    ASSERT_TRUE(change->old()->isNull(1));
+
+    ReplicationTestRow row{};
+    row.info = "kept";
+    *change >> row;
+    ASSERT_EQ(2, row.id);
+    ASSERT_EQ("kept", row.info);
+    ASSERT_EQ(0.5, row.score);
+    ASSERT_FALSE(row.flag);
+    ASSERT_TRUE(change->tuple().isUnchanged(1));
+}
+
+TEST(ReplicationTest, Delete) {
+    internal::LogicalDecoder decoder{};
+    decoder.decode(makeRelation().data(), 10);
+
+    Message msg{'D'};
+    msg.add(Oid{42}).add('K').add(int16_t{5});
+    msg.text("3").add('n').add('n').add('n').add('n');
+
+    auto const change = decoder.decode(msg.data(), 20);
+    ASSERT_TRUE(change);
+    ASSERT_EQ(ChangeType::DELETE, change->type());
+    ASSERT_EQ("replication_test", change->tuple().relation().name);
+
+    int32_t               id = 0;
+    std::optional<double> score{1.0};
+    change->tuple().accept("id", id);
+    change->tuple().accept("score", score);
+    ASSERT_EQ(3, id);
+    ASSERT_FALSE(score);
+}
+
+TEST(ReplicationTest, Bad) {
+    internal::LogicalDecoder decoder{};
+    ASSERT_THROW(decoder.decode(Message{'I'}.add(Oid{42}).data(), 10), RuntimeError);
+    ASSERT_THROW(decoder.decode(Message{'B'}.add(int64_t{1}).data(), 10), RuntimeError);
+
+    decoder.decode(makeRelation().data(), 10);
+    Message msg{'I'};
+    msg.add(Oid{42}).add('N').add(int16_t{5});
+    msg.text("x").add('n').add('n').add('n').add('n');
+    ReplicationTestRow row{};
+    ASSERT_THROW(*decoder.decode(msg.data(), 20) >> row, LogicError);
+}
+
+TEST(ReplicationTest, Stream) {
+    Connection conn{};
+    conn.execRaw("DROP TABLE IF EXISTS replication_test");
+    conn.execRaw("DROP PUBLICATION IF EXISTS replication_test");
+    conn.create<ReplicationTestRow>();
+    conn.execRaw("CREATE PUBLICATION replication_test FOR TABLE replication_test");
+
+    Connection repl{Config::Builder{}.user("cxx_client")
+                                     .password("cxx_client")
+                                     .dbname("cxx_client")
+                                     .replication(ReplicationMode::LOGICAL)
+                                     .build()};
+    repl.execRaw("CREATE_REPLICATION_SLOT replication_test TEMPORARY LOGICAL pgoutput");
+
+    ReplicationTestRow row{};
+    row.id   = 1;
+    row.info = "one";
+    conn.insert(row);
+
+    auto stream = repl.replicate("replication_test", {"replication_test"});
+    std::optional<Change> insert{};
+    while (auto change = stream.next(1s)) {
+        stream.acknowledge(change->lsn());
+        if (change->type() == ChangeType::INSERT) {
+            insert = std::move(change);
+            break;
+        }
+    }
+
+    ASSERT_TRUE(insert);
+    ASSERT_TRUE(insert->is<ReplicationTestRow>());
+    ReplicationTestRow res{};
+    *insert >> res;
+    ASSERT_EQ(1, res.id);
+    ASSERT_EQ("one", res.info);
+    ASSERT_LE(insert->lsn(), stream.acknowledged());
+
+    conn.execRaw("DROP PUBLICATION replication_test");
+    conn.drop<ReplicationTestRow>();
+}
+
+}  // namespace postgres
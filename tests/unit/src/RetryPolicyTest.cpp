@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <postgres/Error.h>
+#include <postgres/RetryPolicy.h>
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+TEST(RetryPolicyTest, Default) {
+    RetryPolicy const policy{};
+    ASSERT_EQ(5, policy.attempts());
+    ASSERT_EQ(IsolationLevel::DEFAULT, policy.isolation());
+    ASSERT_FALSE(policy.isReadOnly());
+    ASSERT_TRUE(policy.isRetryable("40001"));
+    ASSERT_TRUE(policy.isRetryable("40P01"));
+    ASSERT_FALSE(policy.isRetryable("23505"));
+    ASSERT_FALSE(policy.isRetryable(""));
+}
+
+TEST(RetryPolicyTest, Values) {
+    auto const policy = RetryPolicy{}
+                            .attempts(2)
+                            .isolation(IsolationLevel::REPEATABLE_READ)
+                            .readOnly(true)
+                            .retryOn("55P03");
+    ASSERT_EQ(2, policy.attempts());
+    ASSERT_EQ(IsolationLevel::REPEATABLE_READ, policy.isolation());
+    ASSERT_TRUE(policy.isReadOnly());
+    ASSERT_TRUE(policy.isRetryable("55P03"));
+    ASSERT_TRUE(policy.isRetryable("40001"));
+}
+
+TEST(RetryPolicyTest, Delay) {
+    auto const policy = RetryPolicy{}.backoff(10ms, 40ms);
+    for (auto i = 0; i < 16; ++i) {
+        auto const first = policy.delay(1);
+        ASSERT_LE(5ms, first);
+        ASSERT_GE(10ms, first);
+        auto const third = policy.delay(3);
+        ASSERT_LE(20ms, third);
+        ASSERT_GE(40ms, third);
+        auto const last = policy.delay(100);
+        ASSERT_LE(20ms, last);
+        ASSERT_GE(40ms, last);
+    }
+}
+
+TEST(RetryPolicyTest, Bad) {
+    ASSERT_THROW(RetryPolicy{}.attempts(0), LogicError);
+    ASSERT_THROW(RetryPolicy{}.backoff(-1ms, 1ms), LogicError);
+    ASSERT_THROW(RetryPolicy{}.backoff(2ms, 1ms), LogicError);
+}
+
+}  // namespace postgres
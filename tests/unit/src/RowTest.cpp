@@ -34,6 +34,17 @@ TEST(RowTest, Visit) {
     ASSERT_THROW(conn.exec("SELECT 1::INT")[0] >> tbl, LogicError);
 }
 
+TEST(RowTest, VisitOrder) {
+    Connection   conn{};
+    RowTestTable tbl{};
+    conn.exec("SELECT 2::INT AS y, 1::INT AS x")[0] >> tbl;
+    ASSERT_EQ(1, tbl.x);
+    ASSERT_EQ(2, tbl.y);
+    conn.exec("SELECT 3::INT AS \"X\", 4::INT AS Y, 5::INT AS x")[0] >> tbl;
+    ASSERT_EQ(5, tbl.x);
+    ASSERT_EQ(4, tbl.y);
+}
+
 TEST(RowTest, Index) {
     auto const res = Connection{}.exec("SELECT 1::INT, 2::INT");
     auto const row = res[0];
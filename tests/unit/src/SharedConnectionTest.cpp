@@ -0,0 +1,82 @@
+#include <chrono>
+#include <future>
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Error.h>
+#include <postgres/EventBackend.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+#include <postgres/Row.h>
+#include <postgres/SharedConnection.h>
+
+namespace postgres {
+
+TEST(SharedConnectionTest, Exec) {
+    SharedConnection conn{};
+    ASSERT_TRUE(conn.isOk());
+    auto prep = conn.exec(PrepareData{"shared_select", "SELECT $1::INT"});
+    auto res  = conn.exec(PreparedCommand{"shared_select", 2});
+    ASSERT_TRUE(prep.get().isOk());
+    ASSERT_EQ(2, res.get()[0][0].as<int32_t>());
+}
+
+TEST(SharedConnectionTest, Order) {
+    SharedConnection                 conn{};
+    std::vector<std::future<Result>> results{};
+    for (auto i = 0; i < 64; ++i) {
+        results.push_back(conn.exec(Command{"SELECT $1::INT", i}));
+    }
+    for (auto i = 0; i < 64; ++i) {
+        ASSERT_EQ(i, results[i].get()[0][0].as<int32_t>());
+    }
+}
+
+TEST(SharedConnectionTest, Error) {
+    SharedConnection conn{};
+    auto             before = conn.exec(Command{"SELECT 1::INT"});
+    auto             bad    = conn.exec(Command{"BAD"});
+    auto             after  = conn.exec(Command{"SELECT 2::INT"});
+    ASSERT_EQ(1, before.get()[0][0].as<int32_t>());
+    ASSERT_THROW(bad.get(), SqlError);
+    ASSERT_EQ(2, after.get()[0][0].as<int32_t>());
+    ASSERT_TRUE(conn.isOk());
+}
+
+TEST(SharedConnectionTest, OutOfOrder) {
+    auto conn = SharedConnection::Builder{}.connections(2).backend(EventBackend::IO_URING).build();
+
+    // The least busy connection gets the next statement, so the fast one does not wait.
+    auto slow = conn.exec(Command{"SELECT pg_sleep(0.5)"});
+    auto fast = conn.exec(Command{"SELECT 1::INT"});
+    ASSERT_EQ(1, fast.get()[0][0].as<int32_t>());
+    ASSERT_EQ(std::future_status::timeout, slow.wait_for(std::chrono::seconds{0}));
+    ASSERT_TRUE(slow.get().isOk());
+}
+
+TEST(SharedConnectionTest, SendBad) {
+    SharedConnection conn{};
+    Command          cmd{"SELECT 1"};
+    for (auto i = 0; i < 70000; ++i) {
+        cmd << i;
+    }
+    auto bad  = conn.exec(std::move(cmd));
+    auto good = conn.exec(Command{"SELECT 2::INT"});
+    ASSERT_THROW(bad.get(), RuntimeError);
+    ASSERT_EQ(2, good.get()[0][0].as<int32_t>());
+    ASSERT_TRUE(conn.isOk());
+}
+
+TEST(SharedConnectionTest, Bad) {
+    ASSERT_THROW(SharedConnection::Builder{}.connections(0), LogicError);
+}
+
+TEST(SharedConnectionTest, Lost) {
+    SharedConnection conn{};
+    auto             kill = conn.exec(Command{"SELECT pg_terminate_backend(pg_backend_pid())"});
+    ASSERT_THROW(kill.get(), RuntimeError);
+    ASSERT_FALSE(conn.isOk());
+    ASSERT_THROW(conn.exec(Command{"SELECT 1"}).get(), RuntimeError);
+}
+
+}  // namespace postgres
@@ -31,6 +31,13 @@ struct StatementTestTable2 {
     POSTGRES_CXX_TABLE("stmt_test", b, i2, i4, i8, u2, u4, u8, f4, f8, s, t)
 };
 
+struct StatementTestSerialTable {
+    uint32_t    id = 0;
+    std::string s;
+
+    POSTGRES_CXX_TABLE("stmt_serial_test", id, s)
+};
+
 TEST(StatementTest, Create) {
     auto const query = "CREATE TABLE stmt_test ("
                        "b BOOL,"
@@ -80,4 +87,14 @@ TEST(StatementTest, Range) {
     ASSERT_EQ("($2,$3,$4),($5,$6,$7)", RangeStatement::placeholders(v.begin(), v.end(), 1));
 }
 
+TEST(StatementTest, RangeReturning) {
+    auto const query = "INSERT INTO stmt_serial_test (id,s) VALUES (DEFAULT,$1),(DEFAULT,$2)"
+                       " RETURNING id,s";
+
+    std::vector<StatementTestSerialTable> const v(2);
+    ASSERT_EQ(query, RangeStatement::insertReturning(v.begin(), v.end()));
+    ASSERT_EQ("(DEFAULT,$2),(DEFAULT,$3)", RangeStatement::values(v.begin(), v.end(), 1));
+    ASSERT_EQ("(DEFAULT,$1)", RangeStatement::values(v.begin(), v.begin() + 1));
+}
+
 }  // namespace postgres
@@ -0,0 +1,132 @@
+#include <vector>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Error.h>
+#include <postgres/Stream.h>
+#include "Samples.h"
+
+namespace postgres {
+
+TEST(StreamTest, Rows) {
+    Connection           conn{};
+    std::vector<int32_t> vals{};
+    for (auto const& row : conn.stream(Command{SELECT_MULTI_ROW}, 2)) {
+        vals.push_back(row[0].as<int32_t>());
+    }
+    ASSERT_EQ((std::vector<int32_t>{1, 2, 3}), vals);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+TEST(StreamTest, Args) {
+    Connection conn{};
+    auto       n      = 0;
+    auto       sum    = 0;
+    auto       stream = conn.stream(Command{"SELECT generate_series(1, $1)", 1000}, 64);
+    for (auto const& row : stream) {
+        ++n;
+        sum += row[0].as<int32_t>();
+    }
+    ASSERT_EQ(1000, n);
+    ASSERT_EQ(500500, sum);
+    ASSERT_TRUE(stream.chunk().isEmpty());
+}
+
+TEST(StreamTest, Empty) {
+    Connection conn{};
+    auto       n = 0;
+    for (auto const& row : conn.stream(Command{"SELECT 1 WHERE FALSE"})) {
+        row[0].as<int32_t>();
+        ++n;
+    }
+    ASSERT_EQ(0, n);
+}
+
+TEST(StreamTest, Abandon) {
+    Connection conn{};
+    {
+        auto stream = conn.stream(Command{"SELECT generate_series(1, 1000)"}, 10);
+        ASSERT_EQ(1, (*stream.begin())[0].as<int32_t>());
+    }
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+}
+
+TEST(StreamTest, Transaction) {
+    Connection conn{};
+    auto const tx = conn.begin();
+    {
+        auto stream = conn.stream(Command{SELECT_MULTI_ROW}, 1);
+        ASSERT_EQ(3, std::distance(stream.begin(), stream.end()));
+    }
+    ASSERT_EQ(PQTRANS_INTRANS, PQtransactionStatus(conn.native()));
+}
+
+TEST(StreamTest, Bad) {
+    Connection conn{};
+    ASSERT_THROW(conn.stream(Command{SELECT_MULTI_ROW}, 0), LogicError);
+    ASSERT_THROW(conn.stream(Command{"BAD"}), RuntimeError);
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+}
+
+TEST(StreamTest, Cursor) {
+    Connection conn{};
+    auto       n   = 0;
+    auto       sum = 0;
+    for (auto const& row : conn.cursor(Command{"SELECT generate_series(1, $1)", 1000}, 64)) {
+        ++n;
+        sum += row[0].as<int32_t>();
+    }
+    ASSERT_EQ(1000, n);
+    ASSERT_EQ(500500, sum);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+TEST(StreamTest, CursorMemory) {
+    Connection conn{};
+    auto       stream = conn.cursor(Command{"SELECT repeat('x', 1000) FROM generate_series(1, 100)"},
+                                    100,
+                                    10000);
+    // The row size is unknown until the first batch, so it is a single row.
+    ASSERT_EQ(1, stream.take().size());
+
+    auto n = 1;
+    while (true) {
+        auto const res = stream.take();
+        if (res.size() == 0) {
+            break;
+        }
+        ASSERT_GE(5, res.size());
+        n += res.size();
+    }
+    ASSERT_EQ(100, n);
+}
+
+TEST(StreamTest, CursorAbandon) {
+    Connection conn{};
+    {
+        auto stream = conn.cursor(Command{"SELECT generate_series(1, 1000)"}, 10);
+        ASSERT_EQ(1, (*stream.begin())[0].as<int32_t>());
+    }
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+TEST(StreamTest, CursorAbandonFailed) {
+    Connection conn{};
+    {
+        // The second batch, already requested, fails on division by zero.
+        auto stream = conn.cursor(Command{"SELECT 1 / (15 - i) FROM generate_series(1, 100) i"}, 10);
+        ASSERT_EQ(0, (*stream.begin())[0].as<int32_t>());
+    }
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+    ASSERT_EQ(1, conn.exec("SELECT 1::INT")[0][0].as<int32_t>());
+}
+
+TEST(StreamTest, CursorBad) {
+    Connection conn{};
+    ASSERT_THROW(conn.cursor(Command{SELECT_MULTI_ROW}, 0), LogicError);
+    ASSERT_THROW(conn.cursor(Command{"BAD"}), RuntimeError);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+}
+
+}  // namespace postgres
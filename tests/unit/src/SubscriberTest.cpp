@@ -0,0 +1,92 @@
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <gtest/gtest.h>
+#include <postgres/Command.h>
+#include <postgres/Connection.h>
+#include <postgres/Notification.h>
+#include <postgres/Subscriber.h>
+#include "Samples.h"
+
+using namespace std::chrono_literals;
+
+namespace postgres {
+
+TEST(SubscriberTest, Notify) {
+    std::once_flag              once{};
+    std::promise<void>          ready{};
+    std::optional<Notification> last{};
+    std::condition_variable     received{};
+    std::mutex                  mtx{};
+    auto                        sub = Subscriber::Builder{}.uri(CONNECT_URI)
+                                                           .onReset([&once, &ready] {
+                                                               std::call_once(once, [&ready] {
+                                                                   ready.set_value();
+                                                               });
+                                                           })
+                                                           .build();
+    sub.subscribe("subscriber_test", [&last, &received, &mtx](Notification const& note) {
+        std::lock_guard guard{mtx};
+        last = note;
+        received.notify_one();
+    });
+    ASSERT_EQ(std::future_status::ready, ready.get_future().wait_for(1s));
+
+    Connection conn{};
+    for (auto i = 0; i < 10; ++i) {
+        conn.exec(Command{"SELECT pg_notify($1, $2)", "subscriber_test", "payload"});
+        std::unique_lock guard{mtx};
+        if (received.wait_for(guard, 100ms, [&last] {
+                return last.has_value();
+            })) {
+            ASSERT_EQ("subscriber_test", last->channel);
+            ASSERT_EQ("payload", last->payload);
+            ASSERT_LT(0, last->pid);
+            return;
+        }
+    }
+    FAIL() << "no notification received";
+}
+
+TEST(SubscriberTest, Executor) {
+    std::atomic<int> executed{0};
+    std::atomic<int> received{0};
+    auto             sub = Subscriber::Builder{}.executor([&executed](std::function<void()> job) {
+                                                    ++executed;
+                                                    job();
+                                                })
+                                                .build();
+    sub.subscribe("subscriber_test", [&received](Notification const&) {
+        ++received;
+    });
+    sub.subscribe("subscriber_test", [&received](Notification const&) {
+        ++received;
+    });
+
+    Connection conn{};
+    for (auto i = 0; (i < 100) && (received < 2); ++i) {
+        conn.exec(Command{"SELECT pg_notify($1, '')", "subscriber_test"});
+        std::this_thread::sleep_for(10ms);
+    }
+    ASSERT_LE(2, received);
+    ASSERT_LE(received, executed);
+
+    sub.unsubscribe("subscriber_test");
+    std::this_thread::sleep_for(100ms);
+    auto const before = received.load();
+    conn.exec(Command{"SELECT pg_notify($1, '')", "subscriber_test"});
+    std::this_thread::sleep_for(100ms);
+    ASSERT_EQ(before, received);
+}
+
+TEST(SubscriberTest, ConnectBad) {
+    auto sub = Subscriber::Builder{}.uri("BAD").build();
+    sub.subscribe("subscriber_test", [](Notification const&) {
+    });
+}
+
+}  // namespace postgres
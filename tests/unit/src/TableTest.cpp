@@ -2,6 +2,7 @@
 #include <vector>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
+#include <postgres/Error.h>
 #include <postgres/Visitable.h>
 
 namespace postgres {
@@ -76,4 +77,51 @@ TEST_F(TableTest, Select) {
     ASSERT_EQ(2u, out.size());
 }
 
+struct SerialTable {
+    uint32_t id = 0;
+    int32_t  n  = 0;
+
+    POSTGRES_CXX_TABLE("conn_serial_test", id, n);
+};
+
+struct SerialTableTest : testing::Test {
+    SerialTableTest() {
+        conn_.create<SerialTable>();
+    }
+
+    ~SerialTableTest() noexcept override {
+        conn_.drop<SerialTable>();
+    }
+
+    Connection conn_;
+};
+
+TEST_F(SerialTableTest, InsertReturning) {
+    SerialTable in{};
+    in.n = 1;
+    ASSERT_TRUE(conn_.insertReturning(in).isOk());
+    ASSERT_EQ(1u, in.id);
+}
+
+TEST_F(SerialTableTest, MultiInsertReturning) {
+    std::vector<SerialTable> in(3);
+    in[0].n = 1;
+    in[1].n = 2;
+    in[2].n = 3;
+    ASSERT_EQ(3, conn_.insertReturning(in.begin(), in.end()).size());
+    ASSERT_EQ(1u, in[0].id);
+    ASSERT_EQ(2u, in[1].id);
+    ASSERT_EQ(3u, in[2].id);
+    ASSERT_EQ(2, in[1].n);
+
+    std::vector<SerialTable> out{};
+    ASSERT_TRUE(conn_.select(out).isOk());
+    ASSERT_EQ(3u, out.size());
+}
+
+TEST_F(SerialTableTest, EmptyInsertReturning) {
+    std::vector<SerialTable> in{};
+    ASSERT_THROW(conn_.insertReturning(in.begin(), in.end()), LogicError);
+}
+
 }  // namespace postgres
@@ -1,13 +1,21 @@
+#include <chrono>
 #include <gtest/gtest.h>
 #include <postgres/Connection.h>
 #include <postgres/Error.h>
+#include <postgres/PreparedCommand.h>
+#include <postgres/PrepareData.h>
+#include <postgres/RetryPolicy.h>
 #include <postgres/Transaction.h>
 
+using namespace std::chrono_literals;
+
 namespace postgres {
 
 inline auto constexpr CREATE = "CREATE TEMP TABLE tx_test (val INT)";
 inline auto constexpr INSERT = "INSERT INTO tx_test (val) VALUES (1)";
 inline auto constexpr SELECT = "SELECT val FROM tx_test";
+inline auto constexpr CONFLICT =
+    "DO $$BEGIN RAISE EXCEPTION 'conflict' USING ERRCODE = '40001'; END$$";
 
 TEST(TransactionTest, Ok) {
     Connection conn{};
@@ -23,6 +31,21 @@ TEST(TransactionTest, Bad) {
     ASSERT_EQ(0, conn.exec(SELECT).size());
 }
 
+TEST(TransactionTest, Pipeline) {
+    Connection conn{};
+    conn.exec(CREATE);
+    auto const res = conn.transact(INSERT,
+                                   PrepareData{"tx_test_insert", INSERT},
+                                   PreparedCommand{"tx_test_insert"},
+                                   Command{"SELECT count(*)::INT FROM tx_test"});
+    ASSERT_EQ(2, res[0][0].as<int32_t>());
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+
+    ASSERT_THROW(conn.transact(INSERT, CONFLICT, INSERT), SqlError);
+    ASSERT_EQ(PQTRANS_IDLE, PQtransactionStatus(conn.native()));
+    ASSERT_EQ(2, conn.exec(SELECT).size());
+}
+
 TEST(TransactionTest, Commit) {
     Connection conn{};
     conn.exec(CREATE);
@@ -42,6 +65,45 @@ TEST(TransactionTest, Rollback) {
     ASSERT_EQ(0, conn.exec(SELECT).size());
 }
 
+TEST(TransactionTest, Retry) {
+    Connection conn{};
+    conn.exec(CREATE);
+    auto attempts = 0;
+    conn.retryTransaction([&attempts](Connection& conn) {
+        conn.exec(INSERT);
+        if (++attempts == 1) {
+            conn.exec(CONFLICT);
+        }
+    }, RetryPolicy{}.backoff(1ms, 1ms));
+    ASSERT_EQ(2, attempts);
+    ASSERT_EQ(1, conn.exec(SELECT).size());
+
+    attempts = 0;
+    ASSERT_THROW(conn.retryTransaction([&attempts](Connection& conn) {
+        ++attempts;
+        conn.exec(INSERT);
+        conn.exec(CONFLICT);
+    }, RetryPolicy{}.attempts(3).backoff(1ms, 1ms)), SqlError);
+    ASSERT_EQ(3, attempts);
+    ASSERT_THROW(conn.retryTransaction([&attempts](Connection& conn) {
+        ++attempts;
+        conn.exec("BAD");
+    }), SqlError);
+    ASSERT_EQ(4, attempts);
+    ASSERT_EQ(1, conn.exec(SELECT).size());
+}
+
+TEST(TransactionTest, Isolation) {
+    Connection conn{};
+    auto const res = conn.retryTransaction([](Connection& conn) {
+        return conn.exec("SHOW transaction_isolation");
+    }, RetryPolicy{}.isolation(IsolationLevel::SERIALIZABLE).readOnly(true));
+    ASSERT_EQ("serializable", res[0][0].as<std::string>());
+    ASSERT_THROW(conn.retryTransaction([](Connection& conn) {
+        conn.exec(CREATE);
+    }, RetryPolicy{}.readOnly(true)), SqlError);
+}
+
 TEST(TransactionTest, Misuse) {
     Connection conn{};
     auto       tx = conn.begin();
@@ -5,9 +5,12 @@
 #include <postgres/Error.h>
 #include "ChannelMock.h"
 
+using namespace std::chrono_literals;
+
 using testing::_;
 using testing::Invoke;
 using testing::Ref;
+using testing::Return;
 
 namespace postgres::internal {
 
@@ -16,9 +19,13 @@ TEST(WorkerTest, NoRun) {
 }
 
 TEST(WorkerTest, BadRun) {
-    Worker w{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()),
-             std::make_shared<ChannelMock>()};
-    ASSERT_THROW(w.run(), RuntimeError);
+    auto const chan = std::make_shared<ChannelMock>();
+    Worker     w{std::make_shared<Context>(Context::Builder{}.uri("BAD").build()), chan};
+    EXPECT_CALL(*chan, fail(Ref(w), _, _)).WillOnce(Return(1ms))
+                                    .WillOnce(Return(Job::Clock::duration::zero()));
+    EXPECT_CALL(*chan, receive(_)).Times(0);
+    EXPECT_CALL(*chan, recycle(_)).Times(0);
+    w.run();
 }
 
 TEST(WorkerTest, Rerun) {